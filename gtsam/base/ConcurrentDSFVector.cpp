@@ -0,0 +1,165 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ConcurrentDSFVector.cpp
+ * @brief A lock-free DSF that can be merged into from many threads at once
+ */
+
+#include <gtsam/base/ConcurrentDSFVector.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#include <algorithm>
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+ConcurrentDSFBase::ConcurrentDSFBase(const size_t numNodes) :
+    size_(numNodes), v_(new std::atomic<size_t>[numNodes]) {
+  for (size_t index = 0; index < numNodes; index++)
+    v_[index].store(index, memory_order_relaxed);
+}
+
+/* ************************************************************************* */
+size_t ConcurrentDSFBase::find(size_t key) const {
+  // Path halving: make every other node on the path point to its grandparent.
+  // Parents only ever move up the tree, so a failed CAS is harmless.
+  while (true) {
+    size_t parent = v_[key].load(memory_order_acquire);
+    if (parent == key)
+      return key;
+    const size_t grandParent = v_[parent].load(memory_order_acquire);
+    if (grandParent != parent)
+      v_[key].compare_exchange_weak(parent, grandParent, memory_order_release,
+          memory_order_relaxed);
+    key = grandParent;
+  }
+}
+
+/* ************************************************************************* */
+void ConcurrentDSFBase::merge(const size_t& i1, const size_t& i2) {
+  size_t root1 = i1, root2 = i2;
+  while (true) {
+    root1 = find(root1);
+    root2 = find(root2);
+    if (root1 == root2)
+      return;
+    // Link the larger root under the smaller one, fails if it is no longer a root
+    if (root1 > root2)
+      swap(root1, root2);
+    size_t expected = root2;
+    if (v_[root2].compare_exchange_strong(expected, root1,
+        memory_order_acq_rel, memory_order_acquire))
+      return;
+  }
+}
+
+/* ************************************************************************* */
+// Merges a range of pairs
+class _MergePairs {
+  ConcurrentDSFBase& dsf_;
+  const vector<ConcurrentDSFBase::Pair>& pairs_;
+
+ public:
+  _MergePairs(ConcurrentDSFBase& dsf,
+              const vector<ConcurrentDSFBase::Pair>& pairs)
+      : dsf_(dsf), pairs_(pairs) {}
+
+  void operator()(size_t begin, size_t end) const {
+    for (size_t k = begin; k != end; ++k)
+      dsf_.merge(pairs_[k].first, pairs_[k].second);
+  }
+
+#ifdef GTSAM_USE_TBB
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    (*this)(blocked_range.begin(), blocked_range.end());
+  }
+#endif
+};
+
+/* ************************************************************************* */
+void ConcurrentDSFBase::merge(const vector<Pair>& pairs) {
+  _MergePairs mergePairs(*this, pairs);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, pairs.size()), mergePairs);
+#else
+  mergePairs(0, pairs.size());
+#endif
+}
+
+/* ************************************************************************* */
+void ConcurrentDSFBase::flatten() {
+  // Parents have smaller indices, so they are final by the time we reach a key
+  for (size_t key = 0; key < size_; key++) {
+    const size_t parent = v_[key].load(memory_order_relaxed);
+    v_[key].store(v_[parent].load(memory_order_relaxed), memory_order_relaxed);
+  }
+}
+
+/* ************************************************************************* */
+ConcurrentDSFVector::ConcurrentDSFVector(const size_t numNodes) :
+    ConcurrentDSFBase(numNodes) {
+  keys_.reserve(numNodes);
+  for (size_t index = 0; index < numNodes; index++)
+    keys_.push_back(index);
+}
+
+/* ************************************************************************* */
+ConcurrentDSFVector::ConcurrentDSFVector(const std::vector<size_t>& keys) :
+    ConcurrentDSFBase(1 + *std::max_element(keys.begin(), keys.end())), keys_(keys) {
+}
+
+/* ************************************************************************* */
+bool ConcurrentDSFVector::isSingleton(const size_t& label) const {
+  bool result = false;
+  for(size_t key: keys_) {
+    if (find(key) == label) {
+      if (!result) // find the first occurrence
+        result = true;
+      else
+        return false;
+    }
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+std::set<size_t> ConcurrentDSFVector::set(const size_t& label) const {
+  std::set < size_t > set;
+  for(size_t key: keys_)
+    if (find(key) == label)
+      set.insert(key);
+  return set;
+}
+
+/* ************************************************************************* */
+std::map<size_t, std::set<size_t> > ConcurrentDSFVector::sets() const {
+  std::map<size_t, std::set<size_t> > sets;
+  for(size_t key: keys_)
+    sets[find(key)].insert(key);
+  return sets;
+}
+
+/* ************************************************************************* */
+std::map<size_t, std::vector<size_t> > ConcurrentDSFVector::arrays() const {
+  std::map<size_t, std::vector<size_t> > arrays;
+  for(size_t key: keys_)
+    arrays[find(key)].push_back(key);
+  return arrays;
+}
+
+} // namespace  gtsam
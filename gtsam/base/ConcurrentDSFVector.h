@@ -0,0 +1,108 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ConcurrentDSFVector.h
+ * @brief A lock-free DSF that can be merged into from many threads at once
+ */
+
+#pragma once
+
+#include <gtsam/dllexport.h>
+#include <gtsam/global_includes.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Lock-free variant of DSFBase: find and merge may be called concurrently from
+ * any number of threads, e.g., to merge a large number of pairwise feature
+ * matches into tracks.
+ *
+ * Parent pointers are atomics. find() compresses paths by path halving with
+ * compare-and-swap, and merge() links roots with compare-and-swap, retrying if
+ * another thread linked one of them in the meantime. Roots are linked by index,
+ * the larger under the smaller, so that the label of a set is always its
+ * smallest key, regardless of the order in which merges were done. That makes
+ * the result of a parallel merge identical to a sequential one.
+ *
+ * Unlike DSFBase, this class is not copyable.
+ * @addtogroup base
+ */
+class GTSAM_EXPORT ConcurrentDSFBase {
+
+public:
+  typedef std::pair<size_t, size_t> Pair; ///< Pair of keys to merge
+
+private:
+  size_t size_;
+  std::unique_ptr<std::atomic<size_t>[]> v_; ///< Parent pointers, representative iff v[i]==i
+
+public:
+  /// Constructor that allocates new memory, allows for keys 0...numNodes-1.
+  ConcurrentDSFBase(const size_t numNodes);
+
+  /// Number of keys
+  size_t size() const { return size_; }
+
+  /// Find the label of the set in which {key} lives, i.e., its smallest key.
+  size_t find(size_t key) const;
+
+  /// Merge the sets containing i1 and i2. Does nothing if i1 and i2 are already in the same set.
+  void merge(const size_t& i1, const size_t& i2);
+
+  /// Merge all pairs, in parallel if TBB is enabled.
+  void merge(const std::vector<Pair>& pairs);
+
+  /// Point every key directly to its label, so subsequent finds take constant time.
+  void flatten();
+};
+
+/**
+ * ConcurrentDSFVector additionally keeps a vector of keys to support the more
+ * expensive operations of DSFVector. Those are not meant to be called while
+ * other threads are still merging.
+ * @addtogroup base
+ */
+class GTSAM_EXPORT ConcurrentDSFVector: public ConcurrentDSFBase {
+
+private:
+  std::vector<size_t> keys_; ///< stores keys to support more expensive operations
+
+public:
+  /// Constructor that allocates new memory, uses sequential keys 0...numNodes-1.
+  ConcurrentDSFVector(const size_t numNodes);
+
+  /// Constructor that allocates memory, uses given keys.
+  ConcurrentDSFVector(const std::vector<size_t>& keys);
+
+  // All operations below loop over all keys and hence are *at least* O(n)
+
+  /// Find whether there is one and only one occurrence for the given {label}.
+  bool isSingleton(const size_t& label) const;
+
+  /// Get the nodes in the tree with the given label
+  std::set<size_t> set(const size_t& label) const;
+
+  /// Return all sets, i.e. a partition of all elements.
+  std::map<size_t, std::set<size_t> > sets() const;
+
+  /// Return all sets, i.e. a partition of all elements.
+  std::map<size_t, std::vector<size_t> > arrays() const;
+};
+
+}
@@ -32,6 +32,15 @@
 // Use TBB concurrent_unordered_map for ConcurrentMap
 #  define CONCURRENT_MAP_BASE tbb::concurrent_unordered_map<KEY, VALUE>
 
+#elif defined GTSAM_FLAT_CONTAINERS
+
+// Users of ConcurrentMap, e.g. VectorValues, rely on iterators staying valid
+// when inserting, so keep a std::map rather than a flat FastMap
+#  include <gtsam/base/FastDefaultAllocator.h>
+#  include <map>
+#  define CONCURRENT_MAP_BASE std::map<KEY, VALUE, std::less<KEY>, \
+    typename internal::FastDefaultAllocator<std::pair<const KEY, VALUE> >::type>
+
 #else
 
 // If we're not using TBB, use a FastMap for ConcurrentMap
@@ -23,24 +23,48 @@
 #include <boost/serialization/map.hpp>
 #include <map>
 
+#ifdef GTSAM_FLAT_CONTAINERS
+#include <boost/container/flat_map.hpp>
+#include <boost/serialization/split_member.hpp>
+#endif
+
 namespace gtsam {
 
+namespace internal {
+  /// The container FastMap derives from, a std::map unless GTSAM_FLAT_CONTAINERS is defined
+  template<typename KEY, typename VALUE>
+  struct FastMapBase {
+#ifdef GTSAM_FLAT_CONTAINERS
+    typedef boost::container::flat_map<KEY, VALUE, std::less<KEY>,
+      typename FastDefaultVectorAllocator<std::pair<KEY, VALUE> >::type> type;
+#else
+    typedef std::map<KEY, VALUE, std::less<KEY>,
+      typename FastDefaultAllocator<std::pair<const KEY, VALUE> >::type> type;
+#endif
+  };
+}
+
 /**
  * FastMap is a thin wrapper around std::map that uses the boost
  * fast_pool_allocator instead of the default STL allocator.  This is just a
  * convenience to avoid having lengthy types in the code.  Through timing,
  * we've seen that the fast_pool_allocator can lead to speedups of several
  * percent.
+ *
+ * If GTSAM is built with GTSAM_FLAT_CONTAINERS, FastMap is a
+ * boost::container::flat_map instead, i.e., a sorted vector. Iteration is still
+ * in key order, lookups are binary searches in contiguous memory, and inserting
+ * and erasing are linear in the size of the map, which pays off for the small
+ * maps and sets of keys that dominate in GTSAM. Note that inserting or erasing
+ * then invalidates iterators and references into the map.
  * @addtogroup base
  */
 template<typename KEY, typename VALUE>
-class FastMap : public std::map<KEY, VALUE, std::less<KEY>,
-  typename internal::FastDefaultAllocator<std::pair<const KEY, VALUE> >::type> {
+class FastMap : public internal::FastMapBase<KEY, VALUE>::type {
 
 public:
 
-  typedef std::map<KEY, VALUE, std::less<KEY>,
-    typename internal::FastDefaultAllocator<std::pair<const KEY, VALUE> >::type > Base;
+  typedef typename internal::FastMapBase<KEY, VALUE>::type Base;
 
   /** Default constructor */
   FastMap() {}
@@ -69,10 +93,27 @@ public:
 private:
   /** Serialization function */
   friend class boost::serialization::access;
+#ifdef GTSAM_FLAT_CONTAINERS
+  // Boost serialization has no support for flat containers, go through std::map
+  template<class ARCHIVE>
+  void save(ARCHIVE & ar, const unsigned int /*version*/) const {
+    const std::map<KEY, VALUE> map(this->begin(), this->end());
+    ar & BOOST_SERIALIZATION_NVP(map);
+  }
+  template<class ARCHIVE>
+  void load(ARCHIVE & ar, const unsigned int /*version*/) {
+    std::map<KEY, VALUE> map;
+    ar & BOOST_SERIALIZATION_NVP(map);
+    Base::clear();
+    Base::insert(boost::container::ordered_unique_range, map.begin(), map.end());
+  }
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
+#else
   template<class ARCHIVE>
   void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
     ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Base);
   }
+#endif
 };
 
 }
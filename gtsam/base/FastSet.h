@@ -26,6 +26,12 @@
 #include <functional>
 #include <set>
 
+#ifdef GTSAM_FLAT_CONTAINERS
+#include <boost/assign/list_inserter.hpp>
+#include <boost/container/flat_set.hpp>
+#include <boost/serialization/split_member.hpp>
+#endif
+
 namespace boost {
 namespace serialization {
 class access;
@@ -34,23 +40,38 @@ class access;
 
 namespace gtsam {
 
+namespace internal {
+  /// The container FastSet derives from, a std::set unless GTSAM_FLAT_CONTAINERS is defined
+  template<typename VALUE>
+  struct FastSetBase {
+#ifdef GTSAM_FLAT_CONTAINERS
+    typedef boost::container::flat_set<VALUE, std::less<VALUE>,
+      typename FastDefaultVectorAllocator<VALUE>::type> type;
+#else
+    typedef std::set<VALUE, std::less<VALUE>,
+      typename FastDefaultAllocator<VALUE>::type> type;
+#endif
+  };
+}
+
 /**
  * FastSet is a thin wrapper around std::set that uses the boost
  * fast_pool_allocator instead of the default STL allocator.  This is just a
  * convenience to avoid having lengthy types in the code.  Through timing,
  * we've seen that the fast_pool_allocator can lead to speedups of several %.
+ *
+ * If GTSAM is built with GTSAM_FLAT_CONTAINERS, FastSet is a sorted vector
+ * (boost::container::flat_set) instead, see FastMap.
  * @addtogroup base
  */
 template<typename VALUE>
-class FastSet: public std::set<VALUE, std::less<VALUE>,
-    typename internal::FastDefaultAllocator<VALUE>::type> {
+class FastSet: public internal::FastSetBase<VALUE>::type {
 
   BOOST_CONCEPT_ASSERT ((IsTestable<VALUE> ));
 
 public:
 
-  typedef std::set<VALUE, std::less<VALUE>,
-  typename internal::FastDefaultAllocator<VALUE>::type> Base;
+  typedef typename internal::FastSetBase<VALUE>::type Base;
 
   /** Default constructor */
   FastSet() {
@@ -125,10 +146,40 @@ public:
 private:
   /** Serialization function */
   friend class boost::serialization::access;
+#ifdef GTSAM_FLAT_CONTAINERS
+  // Boost serialization has no support for flat containers, go through std::set
+  template<class ARCHIVE>
+  void save(ARCHIVE & ar, const unsigned int /*version*/) const {
+    const std::set<VALUE> set(this->begin(), this->end());
+    ar & BOOST_SERIALIZATION_NVP(set);
+  }
+  template<class ARCHIVE>
+  void load(ARCHIVE & ar, const unsigned int /*version*/) {
+    std::set<VALUE> set;
+    ar & BOOST_SERIALIZATION_NVP(set);
+    Base::clear();
+    Base::insert(boost::container::ordered_unique_range, set.begin(), set.end());
+  }
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
+#else
   template<class ARCHIVE>
   void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
     ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Base);
   }
+#endif
 };
 
 }
+
+#ifdef GTSAM_FLAT_CONTAINERS
+namespace boost {
+namespace assign {
+  /// Same as the std::set version in boost/assign/std/set.hpp, so "keys += 1, 2, 3;" still works
+  template<class K, class C, class A, class K2>
+  inline list_inserter<assign_detail::call_insert<container::flat_set<K, C, A> >, K>
+  operator+=(container::flat_set<K, C, A>& c, K2&& k) {
+    return insert(c)(boost::forward<K2>(k));
+  }
+}
+}
+#endif
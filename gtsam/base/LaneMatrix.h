@@ -0,0 +1,166 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    LaneMatrix.h
+ * @brief   Small fixed-size matrices of SIMD lanes, for structure-of-arrays kernels
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+
+#include <algorithm>
+
+namespace gtsam {
+namespace internal {
+
+/// Number of independent problems processed together in a lane kernel
+enum { kLaneWidth = 4 };
+
+/// One scalar quantity across kLaneWidth independent problems
+typedef Eigen::Array<double, kLaneWidth, 1> Lanes;
+
+/// Per-lane boolean, e.g., to select between two branches of a formula
+typedef Eigen::Array<bool, kLaneWidth, 1> LaneMask;
+
+/// Index of lane k in the block starting at i, of n elements in total. The
+/// last element is replicated so the tail of a partial block is well defined.
+inline size_t laneIndex(size_t i, int k, size_t n) {
+  return std::min(i + k, n - 1);
+}
+
+/// Number of real elements in the block starting at i
+inline size_t lanesUsed(size_t i, size_t n) {
+  return std::min(n - i, size_t(kLaneWidth));
+}
+
+/**
+ * Small fixed-size matrix whose entries are Lanes. All operations are
+ * element-wise on the lanes, so kernels written with LaneMatrix vectorize
+ * across problems rather than within one small matrix.
+ */
+template <int M, int N>
+struct LaneMatrix {
+  Lanes v[M][N];
+
+  Lanes& operator()(int i, int j) { return v[i][j]; }
+  const Lanes& operator()(int i, int j) const { return v[i][j]; }
+
+  void setZero() {
+    for (int i = 0; i < M; i++)
+      for (int j = 0; j < N; j++) v[i][j].setZero();
+  }
+
+  void setIdentity() {
+    for (int i = 0; i < M; i++)
+      for (int j = 0; j < N; j++) v[i][j].setConstant(i == j ? 1.0 : 0.0);
+  }
+
+  /// Set lane k from a fixed-size matrix
+  template <typename Derived>
+  void setLane(int k, const Eigen::MatrixBase<Derived>& A) {
+    for (int i = 0; i < M; i++)
+      for (int j = 0; j < N; j++) v[i][j](k) = A(i, j);
+  }
+
+  /// Get lane k as a fixed-size matrix
+  Eigen::Matrix<double, M, N> lane(int k) const {
+    Eigen::Matrix<double, M, N> A;
+    for (int i = 0; i < M; i++)
+      for (int j = 0; j < N; j++) A(i, j) = v[i][j](k);
+    return A;
+  }
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+typedef LaneMatrix<3, 1> Lanes3;
+typedef LaneMatrix<3, 3> Lanes33;
+
+template <int M, int K, int N>
+LaneMatrix<M, N> operator*(const LaneMatrix<M, K>& A,
+                           const LaneMatrix<K, N>& B) {
+  LaneMatrix<M, N> C;
+  for (int i = 0; i < M; i++)
+    for (int j = 0; j < N; j++) {
+      C(i, j) = A(i, 0) * B(0, j);
+      for (int k = 1; k < K; k++) C(i, j) += A(i, k) * B(k, j);
+    }
+  return C;
+}
+
+/// A * B^T
+template <int M, int K, int N>
+LaneMatrix<M, N> multiplyTranspose(const LaneMatrix<M, K>& A,
+                                   const LaneMatrix<N, K>& B) {
+  LaneMatrix<M, N> C;
+  for (int i = 0; i < M; i++)
+    for (int j = 0; j < N; j++) {
+      C(i, j) = A(i, 0) * B(j, 0);
+      for (int k = 1; k < K; k++) C(i, j) += A(i, k) * B(j, k);
+    }
+  return C;
+}
+
+/// A^T * B
+template <int K, int M, int N>
+LaneMatrix<M, N> transposeMultiply(const LaneMatrix<K, M>& A,
+                                   const LaneMatrix<K, N>& B) {
+  LaneMatrix<M, N> C;
+  for (int i = 0; i < M; i++)
+    for (int j = 0; j < N; j++) {
+      C(i, j) = A(0, i) * B(0, j);
+      for (int k = 1; k < K; k++) C(i, j) += A(k, i) * B(k, j);
+    }
+  return C;
+}
+
+/// A * S * A^T for a matrix S shared by all lanes
+template <int M>
+LaneMatrix<M, M> sandwich(const LaneMatrix<M, 3>& A, const Matrix3& S) {
+  LaneMatrix<M, 3> AS;
+  for (int i = 0; i < M; i++)
+    for (int j = 0; j < 3; j++)
+      AS(i, j) = A(i, 0) * S(0, j) + A(i, 1) * S(1, j) + A(i, 2) * S(2, j);
+  return multiplyTranspose(AS, A);
+}
+
+/// Skew-symmetric matrix of a 3-vector, lane-wise
+inline Lanes33 skew(const Lanes3& w) {
+  Lanes33 W;
+  W(0, 0).setZero();  W(0, 1) = -w(2, 0); W(0, 2) = w(1, 0);
+  W(1, 0) = w(2, 0);  W(1, 1).setZero();  W(1, 2) = -w(0, 0);
+  W(2, 0) = -w(1, 0); W(2, 1) = w(0, 0);  W(2, 2).setZero();
+  return W;
+}
+
+/// Inverse of a 3*3 matrix via the adjugate, lane-wise
+inline Lanes33 inverse(const Lanes33& M) {
+  Lanes33 adj;
+  adj(0, 0) = M(1, 1) * M(2, 2) - M(1, 2) * M(2, 1);
+  adj(0, 1) = M(0, 2) * M(2, 1) - M(0, 1) * M(2, 2);
+  adj(0, 2) = M(0, 1) * M(1, 2) - M(0, 2) * M(1, 1);
+  adj(1, 0) = M(1, 2) * M(2, 0) - M(1, 0) * M(2, 2);
+  adj(1, 1) = M(0, 0) * M(2, 2) - M(0, 2) * M(2, 0);
+  adj(1, 2) = M(0, 2) * M(1, 0) - M(0, 0) * M(1, 2);
+  adj(2, 0) = M(1, 0) * M(2, 1) - M(1, 1) * M(2, 0);
+  adj(2, 1) = M(0, 1) * M(2, 0) - M(0, 0) * M(2, 1);
+  adj(2, 2) = M(0, 0) * M(1, 1) - M(0, 1) * M(1, 0);
+  const Lanes invDet = (M(0, 0) * adj(0, 0) + M(0, 1) * adj(1, 0)
+      + M(0, 2) * adj(2, 0)).inverse();
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) adj(i, j) *= invDet;
+  return adj;
+}
+
+} // namespace internal
+} // namespace gtsam
@@ -0,0 +1,197 @@
+/* ----------------------------------------------------------------------------
+
+* GTSAM Copyright 2010, Georgia Tech Research Corporation,
+* Atlanta, Georgia 30332-0415
+* All Rights Reserved
+* Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+* See LICENSE for the license information
+
+* -------------------------------------------------------------------------- */
+
+/**
+* @file    PackedSymmetricBlockMatrix.cpp
+* @brief   Symmetric block matrix that only stores the blocks on and above the diagonal
+*/
+
+#include <gtsam/base/PackedSymmetricBlockMatrix.h>
+#include <gtsam/base/VerticalBlockMatrix.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/base/ThreadsafeException.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace gtsam {
+
+// Same threshold as choleskyPartial uses to detect underconstrained systems
+static const int underconstrainedExponentDifference = 12;
+
+/* ************************************************************************* */
+PackedSymmetricBlockMatrix::PackedSymmetricBlockMatrix(
+    const SymmetricBlockMatrix& other) :
+    blockStart_(0) {
+  FastVector<DenseIndex> dims;
+  for (DenseIndex j = 0; j < other.nBlocks(); ++j)
+    dims.push_back(other.getDim(j));
+  fillOffsets(dims.begin(), dims.end(), false);
+  for (DenseIndex j = 0; j < nBlocks(); ++j) {
+    for (DenseIndex i = 0; i < j; ++i)
+      block_(i, j) = other.aboveDiagonalBlock(i, j);
+    setDiagonalBlock(j, other.block(j, j));
+  }
+}
+
+/* ************************************************************************* */
+SymmetricBlockMatrix PackedSymmetricBlockMatrix::unpack() const {
+  FastVector<DenseIndex> dims;
+  for (DenseIndex j = 0; j < nBlocks(); ++j)
+    dims.push_back(getDim(j));
+  SymmetricBlockMatrix result(dims);
+  for (DenseIndex j = 0; j < nBlocks(); ++j) {
+    for (DenseIndex i = 0; i < j; ++i)
+      result.setOffDiagonalBlock(i, j, block_(i, j));
+    result.setDiagonalBlock(j, block_(j, j));
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+Matrix PackedSymmetricBlockMatrix::block(DenseIndex I, DenseIndex J) const {
+  if (I == J) {
+    return diagonalBlock(I);
+  } else if (I < J) {
+    return aboveDiagonalBlock(I, J);
+  } else {
+    return aboveDiagonalBlock(J, I).transpose();
+  }
+}
+
+/* ************************************************************************* */
+Matrix PackedSymmetricBlockMatrix::selfadjointView() const {
+  Matrix result(rows(), cols());
+  const DenseIndex start = offset(0);
+  for (DenseIndex j = 0; j < nBlocks(); ++j) {
+    const DenseIndex cj = offset(j) - start;
+    for (DenseIndex i = 0; i < j; ++i) {
+      const DenseIndex ri = offset(i) - start;
+      result.block(ri, cj, getDim(i), getDim(j)) = block_(i, j);
+      result.block(cj, ri, getDim(j), getDim(i)) = block_(i, j).transpose();
+    }
+    result.block(cj, cj, getDim(j), getDim(j)) = diagonalBlock(j);
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+Vector PackedSymmetricBlockMatrix::multiply(const Vector& x) const {
+  assert(x.size() == cols());
+  Vector y = Vector::Zero(rows());
+  const DenseIndex start = offset(0);
+  for (DenseIndex j = 0; j < nBlocks(); ++j) {
+    const DenseIndex cj = offset(j) - start, dj = getDim(j);
+    for (DenseIndex i = 0; i < j; ++i) {
+      const DenseIndex ri = offset(i) - start, di = getDim(i);
+      const constBlock Aij = block_(i, j);
+      y.segment(ri, di).noalias() += Aij * x.segment(cj, dj);
+      y.segment(cj, dj).noalias() += Aij.transpose() * x.segment(ri, di);
+    }
+    y.segment(cj, dj).noalias() += diagonalBlock(j) * x.segment(cj, dj);
+  }
+  return y;
+}
+
+/* ************************************************************************* */
+void PackedSymmetricBlockMatrix::setZero() {
+  for (DenseIndex j = 0; j < nBlocks(); ++j) {
+    for (DenseIndex i = 0; i < j; ++i)
+      block_(i, j).setZero();
+    block_(j, j).triangularView<Eigen::Upper>().setZero();
+  }
+}
+
+/* ************************************************************************* */
+void PackedSymmetricBlockMatrix::negate() {
+  for (DenseIndex j = 0; j < nBlocks(); ++j) {
+    for (DenseIndex i = 0; i < j; ++i)
+      block_(i, j) *= -1.0;
+    block_(j, j).triangularView<Eigen::Upper>() *= -1.0;
+  }
+}
+
+/* ************************************************************************* */
+void PackedSymmetricBlockMatrix::choleskyPartial(DenseIndex nFrontals) {
+  gttic(PackedSymmetricBlockMatrix_choleskyPartial);
+  assert(nFrontals <= nBlocks());
+  const DenseIndex n = nBlocks();
+  for (DenseIndex k = 0; k < nFrontals; ++k) {
+    // Factor the diagonal block, Akk = Rkk'*Rkk
+    Block Akk = block_(k, k);
+    Eigen::LLT<Matrix, Eigen::Upper> llt(Akk);
+    if (llt.info() != Eigen::Success)
+      throw CholeskyFailed();
+    Akk.triangularView<Eigen::Upper>() = llt.matrixU();
+
+    // Row panel Akj <- inv(Rkk') * Akj
+    for (DenseIndex j = k + 1; j < n; ++j) {
+      Block Akj = block_(k, j);
+      Akk.triangularView<Eigen::Upper>().transpose().solveInPlace(Akj);
+    }
+
+    // Trailing update Aij <- Aij - Aki' * Akj, one block column at a time
+    for (DenseIndex j = k + 1; j < n; ++j) {
+      const Block Akj = block_(k, j);
+      for (DenseIndex i = k + 1; i < j; ++i)
+        block_(i, j).noalias() -= block_(k, i).transpose() * Akj;
+      block_(j, j).selfadjointView<Eigen::Upper>().rankUpdate(Akj.transpose(), -1.0);
+    }
+  }
+
+  // Check last diagonal elements - Eigen does not check them
+  if (nFrontals > 0) {
+    Vector pivots(offset(nFrontals) - offset(0));
+    for (DenseIndex k = 0; k < nFrontals; ++k)
+      pivots.segment(offset(k) - offset(0), getDim(k)) = diagonal(k);
+    const DenseIndex m = pivots.size();
+    int exp2, exp1;
+    if (m >= 2) {
+      (void)frexp(pivots(m - 2), &exp2);
+      (void)frexp(pivots(m - 1), &exp1);
+      if (exp2 - exp1 >= underconstrainedExponentDifference)
+        throw CholeskyFailed();
+    } else if (m == 1) {
+      (void)frexp(pivots(0), &exp1);
+      if (exp1 <= -underconstrainedExponentDifference)
+        throw CholeskyFailed();
+    }
+  }
+}
+
+/* ************************************************************************* */
+VerticalBlockMatrix PackedSymmetricBlockMatrix::split(DenseIndex nFrontals) {
+  gttic(PackedSymmetricBlockMatrix_split);
+
+  // Construct a VerticalBlockMatrix that contains [R Sd]
+  FastVector<DenseIndex> dims;
+  for (DenseIndex j = 0; j < nBlocks(); ++j)
+    dims.push_back(getDim(j));
+  const DenseIndex n1 = offset(nFrontals) - offset(0);
+  VerticalBlockMatrix RSd(dims, n1);
+  RSd.full().setZero();
+
+  // Copy the first nFrontals block rows into it
+  for (DenseIndex j = 0; j < nBlocks(); ++j) {
+    for (DenseIndex i = 0; i < std::min(j, nFrontals); ++i)
+      RSd(j).middleRows(offset(i) - offset(0), getDim(i)) = block_(i, j);
+    if (j < nFrontals)
+      RSd(j).middleRows(offset(j) - offset(0), getDim(j))
+          .triangularView<Eigen::Upper>() = block_(j, j);
+  }
+
+  // The remaining blocks are the factor on the separator
+  blockStart() += nFrontals;
+
+  return RSd;
+}
+
+} // namespace gtsam
@@ -0,0 +1,269 @@
+/* ----------------------------------------------------------------------------
+
+* GTSAM Copyright 2010, Georgia Tech Research Corporation,
+* Atlanta, Georgia 30332-0415
+* All Rights Reserved
+* Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+* See LICENSE for the license information
+
+* -------------------------------------------------------------------------- */
+
+/**
+* @file    PackedSymmetricBlockMatrix.h
+* @brief   Symmetric block matrix that only stores the blocks on and above the diagonal
+*/
+#pragma once
+
+#include <gtsam/base/SymmetricBlockMatrix.h>
+#include <gtsam/base/FastVector.h>
+#include <gtsam/base/Matrix.h>
+#include <gtsam/base/types.h>
+#include <gtsam/dllexport.h>
+#include <boost/serialization/nvp.hpp>
+#include <cassert>
+
+namespace gtsam {
+
+  // Forward declarations
+  class VerticalBlockMatrix;
+
+  /**
+  * A symmetric matrix accessed as a collection of blocks, like SymmetricBlockMatrix, but with
+  * packed storage: block column J only stores the blocks (0..J, J), contiguously and in
+  * column-major order, so the blocks below the diagonal take no memory.  This halves the memory
+  * of large augmented Hessians, and keeps each block column contiguous for the block Cholesky.
+  *
+  * As for SymmetricBlockMatrix, only the upper triangular part of the diagonal blocks is used,
+  * and blockStart() determines the block that appears to have index 0.
+  *
+  * @addtogroup base */
+  class GTSAM_EXPORT PackedSymmetricBlockMatrix
+  {
+  public:
+    typedef PackedSymmetricBlockMatrix This;
+    typedef Eigen::Map<Matrix, 0, Eigen::OuterStride<> > Block;
+    typedef Eigen::Map<const Matrix, 0, Eigen::OuterStride<> > constBlock;
+
+  protected:
+    Vector data_; ///< The packed block columns
+    FastVector<DenseIndex> variableColOffsets_; ///< the starting columns of each block (0-based)
+    FastVector<DenseIndex> blockColumnStarts_; ///< the start of each block column in data_
+
+    DenseIndex blockStart_; ///< Changes apparent matrix view, see main class comment.
+
+  public:
+    /// Construct an empty matrix
+    PackedSymmetricBlockMatrix() :
+      blockStart_(0)
+    {
+      variableColOffsets_.push_back(0);
+      blockColumnStarts_.push_back(0);
+    }
+
+    /// Construct from a container of the sizes of each block.
+    template<typename CONTAINER>
+    PackedSymmetricBlockMatrix(const CONTAINER& dimensions, bool appendOneDimension = false) :
+      blockStart_(0)
+    {
+      fillOffsets(dimensions.begin(), dimensions.end(), appendOneDimension);
+    }
+
+    /// Construct by packing the active view of a SymmetricBlockMatrix
+    explicit PackedSymmetricBlockMatrix(const SymmetricBlockMatrix& other);
+
+    /// Unpack the active view into a SymmetricBlockMatrix
+    SymmetricBlockMatrix unpack() const;
+
+    /// Row size
+    DenseIndex rows() const { return variableColOffsets_.back() - variableColOffsets_[blockStart_]; }
+
+    /// Column size
+    DenseIndex cols() const { return rows(); }
+
+    /// Block count
+    DenseIndex nBlocks() const { return variableColOffsets_.size() - 1 - blockStart_; }
+
+    /// Number of dimensions for variable on this diagonal block.
+    DenseIndex getDim(DenseIndex block) const {
+      return offset(block + 1) - offset(block);
+    }
+
+    /// Number of doubles stored, including any blocks before blockStart()
+    DenseIndex storageSize() const { return data_.size(); }
+
+    /// @name Block getter methods.
+    /// @{
+
+    /// Get a copy of a block (anywhere in the matrix).
+    Matrix block(DenseIndex I, DenseIndex J) const;
+
+    /// Return the J'th diagonal block as a self adjoint view.
+    Eigen::SelfAdjointView<Block, Eigen::Upper> diagonalBlock(DenseIndex J) {
+      return block_(J, J).selfadjointView<Eigen::Upper>();
+    }
+
+    /// Return the J'th diagonal block as a self adjoint view.
+    Eigen::SelfAdjointView<constBlock, Eigen::Upper> diagonalBlock(DenseIndex J) const {
+      return block_(J, J).selfadjointView<Eigen::Upper>();
+    }
+
+    /// Get the diagonal of the J'th diagonal block.
+    Vector diagonal(DenseIndex J) const {
+      return block_(J, J).diagonal();
+    }
+
+    /// Get block above the diagonal (I, J).
+    constBlock aboveDiagonalBlock(DenseIndex I, DenseIndex J) const {
+      assert(I < J);
+      return block_(I, J);
+    }
+
+    /// Get block above the diagonal (I, J).
+    Block aboveDiagonalBlock(DenseIndex I, DenseIndex J) {
+      assert(I < J);
+      return block_(I, J);
+    }
+
+    /// Get the dense symmetric matrix, e.g., for printing or testing
+    Matrix selfadjointView() const;
+
+    /// Multiply the symmetric matrix with a vector, y = A*x, one block at a time
+    Vector multiply(const Vector& x) const;
+
+    /// @}
+    /// @name Block setter methods.
+    /// @{
+
+    /// Set a diagonal block. Only the upper triangular portion of `xpr` is evaluated.
+    template <typename XprType>
+    void setDiagonalBlock(DenseIndex I, const XprType& xpr) {
+      block_(I, I).triangularView<Eigen::Upper>() = xpr.template triangularView<Eigen::Upper>();
+    }
+
+    /// Set an off-diagonal block.
+    template <typename XprType>
+    void setOffDiagonalBlock(DenseIndex I, DenseIndex J, const XprType& xpr) {
+      assert(I != J);
+      if (I < J) {
+        block_(I, J) = xpr;
+      } else {
+        block_(J, I) = xpr.transpose();
+      }
+    }
+
+    /// Increment the diagonal block by the values in `xpr`. Only reads the upper triangular part of `xpr`.
+    template <typename XprType>
+    void updateDiagonalBlock(DenseIndex I, const XprType& xpr) {
+      Block dest = block_(I, I);
+      assert(dest.rows() == xpr.rows());
+      assert(dest.cols() == xpr.cols());
+      for (DenseIndex col = 0; col < dest.cols(); ++col) {
+        for (DenseIndex row = 0; row <= col; ++row) {
+          dest(row, col) += xpr(row, col);
+        }
+      }
+    }
+
+    /// Update an off diagonal block.
+    /// NOTE: This assumes noalias().
+    template <typename XprType>
+    void updateOffDiagonalBlock(DenseIndex I, DenseIndex J, const XprType& xpr) {
+      assert(I != J);
+      if (I < J) {
+        block_(I, J).noalias() += xpr;
+      } else {
+        block_(J, I).noalias() += xpr.transpose();
+      }
+    }
+
+    /// Set the entire active matrix zero.
+    void setZero();
+
+    /// Negate the entire active matrix.
+    void negate();
+
+    /// @}
+
+    /// Retrieve or modify the first logical block, i.e. the block referenced by block index 0.
+    DenseIndex& blockStart() { return blockStart_; }
+
+    /// Retrieve the first logical block, i.e. the block referenced by block index 0.
+    DenseIndex blockStart() const { return blockStart_; }
+
+    /**
+     * Block partial Cholesky on the first nFrontals blocks, with the same result as
+     * SymmetricBlockMatrix::choleskyPartial: [R Sd;0 L] such that R'R = A1'A1,
+     * R'Sd = [A1'A2 A1'b], and L'L is the augmented Hessian on the separator.
+     * Throws CholeskyFailed if the frontal block is not positive definite.
+     */
+    void choleskyPartial(DenseIndex nFrontals);
+
+    /**
+     * After partial Cholesky, split off R and Sd, to be interpreted as a GaussianConditional
+     * |R*x1 + S*x2 - d]^2, and adjust blockStart so *this refers to L.
+     */
+    VerticalBlockMatrix split(DenseIndex nFrontals);
+
+  protected:
+
+    /// Get an offset for a block index (in the active view).
+    DenseIndex offset(DenseIndex block) const {
+      assert(block >= 0);
+      const DenseIndex actual_index = block + blockStart();
+      assert(actual_index < (DenseIndex)variableColOffsets_.size());
+      return variableColOffsets_[actual_index];
+    }
+
+    /// Get block (I, J), I <= J, from the packed storage. Indices are in block units.
+    constBlock block_(DenseIndex I, DenseIndex J) const {
+      assert(I <= J);
+      const DenseIndex i = I + blockStart_, j = J + blockStart_;
+      const DenseIndex height = variableColOffsets_[j + 1];
+      return constBlock(data_.data() + blockColumnStarts_[j] + variableColOffsets_[i],
+          variableColOffsets_[i + 1] - variableColOffsets_[i],
+          variableColOffsets_[j + 1] - variableColOffsets_[j],
+          Eigen::OuterStride<>(height));
+    }
+
+    /// Get block (I, J), I <= J, from the packed storage. Indices are in block units.
+    Block block_(DenseIndex I, DenseIndex J) {
+      assert(I <= J);
+      const DenseIndex i = I + blockStart_, j = J + blockStart_;
+      const DenseIndex height = variableColOffsets_[j + 1];
+      return Block(data_.data() + blockColumnStarts_[j] + variableColOffsets_[i],
+          variableColOffsets_[i + 1] - variableColOffsets_[i],
+          variableColOffsets_[j + 1] - variableColOffsets_[j],
+          Eigen::OuterStride<>(height));
+    }
+
+    template<typename ITERATOR>
+    void fillOffsets(ITERATOR firstBlockDim, ITERATOR lastBlockDim, bool appendOneDimension)
+    {
+      variableColOffsets_.assign(1, 0);
+      for(ITERATOR dim=firstBlockDim; dim!=lastBlockDim; ++dim)
+        variableColOffsets_.push_back(variableColOffsets_.back() + *dim);
+      if(appendOneDimension)
+        variableColOffsets_.push_back(variableColOffsets_.back() + 1);
+
+      // Block column J stores all rows up to and including block J
+      blockColumnStarts_.assign(1, 0);
+      for(size_t j = 0; j + 1 < variableColOffsets_.size(); ++j)
+        blockColumnStarts_.push_back(blockColumnStarts_.back() +
+            variableColOffsets_[j + 1] * (variableColOffsets_[j + 1] - variableColOffsets_[j]));
+      data_.resize(blockColumnStarts_.back());
+    }
+
+  private:
+    /** Serialization function */
+    friend class boost::serialization::access;
+    template<class ARCHIVE>
+    void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+      ar & BOOST_SERIALIZATION_NVP(data_);
+      ar & BOOST_SERIALIZATION_NVP(variableColOffsets_);
+      ar & BOOST_SERIALIZATION_NVP(blockColumnStarts_);
+      ar & BOOST_SERIALIZATION_NVP(blockStart_);
+    }
+  };
+
+}
@@ -70,6 +70,15 @@ void SymmetricBlockMatrix::choleskyPartial(DenseIndex nFrontals) {
   }
 }
 
+/* ************************************************************************* */
+void SymmetricBlockMatrix::choleskyPartialSinglePrecision(DenseIndex nFrontals) {
+  gttic(VerticalBlockMatrix_choleskyPartialSinglePrecision);
+  DenseIndex topleft = variableColOffsets_[blockStart_];
+  if (!gtsam::choleskyPartialSinglePrecision(matrix_, offset(nFrontals) - topleft, topleft)) {
+    throw CholeskyFailed();
+  }
+}
+
 /* ************************************************************************* */
 VerticalBlockMatrix SymmetricBlockMatrix::split(DenseIndex nFrontals) {
   gttic(VerticalBlockMatrix_split);
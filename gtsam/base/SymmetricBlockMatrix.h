@@ -302,6 +302,9 @@ namespace gtsam {
      */
     void choleskyPartial(DenseIndex nFrontals);
 
+    /// Same as choleskyPartial, but factors in single precision, see choleskyPartialSinglePrecision
+    void choleskyPartialSinglePrecision(DenseIndex nFrontals);
+
     /**
      * After partial Cholesky, we can optionally split off R and Sd, to be interpreted as
      * a GaussianConditional |R*x1 + S*x2 - d]^2. We leave the symmetric lower block L in place,
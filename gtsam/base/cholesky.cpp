@@ -19,9 +19,17 @@
 
 #include <gtsam/base/cholesky.h>
 #include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#endif
 
 #include <boost/format.hpp>
+#include <algorithm>
 #include <cmath>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
@@ -32,6 +40,50 @@ static const double zeroPivotThreshold = 1e-6;
 static const double underconstrainedPrior = 1e-5;
 static const int underconstrainedExponentDifference = 12;
 
+// Dense blocks at least this large are factored and solved tile by tile, in
+// parallel.  Below this the thread overhead outweighs the gains.
+static const size_t blockedThreshold = 512;
+
+/* ************************************************************************* */
+// Calls f(i) for i in [0, n), in parallel if GTSAM is built with TBB
+template <class FUNCTION>
+static void parallelFor(size_t n, const FUNCTION& f) {
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(size_t(0), n, f);
+#else
+  for (size_t i = 0; i < n; ++i)
+    f(i);
+#endif
+}
+
+/* ************************************************************************* */
+// Calls f(begin, end) for consecutive ranges of [0, n) of at most tileSize
+template <class FUNCTION>
+static void forEachTile(size_t n, size_t tileSize, const FUNCTION& f) {
+  parallelFor((n + tileSize - 1) / tileSize, [&](size_t t) {
+    f(t * tileSize, std::min(n, (t + 1) * tileSize));
+  });
+}
+
+/* ************************************************************************* */
+// Check last diagonal elements of R - Eigen does not check them
+template <class MATRIX>
+static bool lastPivotsWellConditioned(const MATRIX& ABC, size_t nFrontal,
+                                      size_t topleft) {
+  if (nFrontal >= 2) {
+    int exp2, exp1;
+    (void)frexp(ABC(topleft + nFrontal - 2, topleft + nFrontal - 2), &exp2);
+    (void)frexp(ABC(topleft + nFrontal - 1, topleft + nFrontal - 1), &exp1);
+    return (exp2 - exp1 < underconstrainedExponentDifference);
+  } else if (nFrontal == 1) {
+    int exp1;
+    (void)frexp(ABC(topleft, topleft), &exp1);
+    return (exp1 > -underconstrainedExponentDifference);
+  } else {
+    return true;
+  }
+}
+
 /* ************************************************************************* */
 static inline int choleskyStep(Matrix& ATA, size_t k, size_t order) {
   // Get pivot value
@@ -105,11 +157,9 @@ pair<size_t, bool> choleskyCareful(Matrix& ATA, int order) {
 }
 
 /* ************************************************************************* */
-bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
-  gttic(choleskyPartial);
-  if (nFrontal == 0)
-    return true;
-
+// Unblocked partial Cholesky, in the precision of MATRIX
+template <class MATRIX>
+static bool choleskyPartialDense(MATRIX& ABC, size_t nFrontal, size_t topleft) {
   assert(ABC.cols() == ABC.rows());
   assert(size_t(ABC.rows()) >= topleft);
   const size_t n = static_cast<size_t>(ABC.rows() - topleft);
@@ -122,11 +172,11 @@ bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
 
   // Compute Cholesky factorization A = R'*R, overwrites A.
   gttic(LLT);
-  Eigen::LLT<Matrix, Eigen::Upper> llt(A);
+  Eigen::LLT<MATRIX, Eigen::Upper> llt(A);
   Eigen::ComputationInfo lltResult = llt.info();
   if (lltResult != Eigen::Success)
     return false;
-  auto R = A.triangularView<Eigen::Upper>();
+  auto R = A.template triangularView<Eigen::Upper>();
   R = llt.matrixU();
   gttoc(LLT);
 
@@ -139,22 +189,157 @@ bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
   // Compute L = C - S' * S
   gttic(compute_L);
   if (nFrontal < n)
-    C.selfadjointView<Eigen::Upper>().rankUpdate(B.transpose(), -1.0);
+    C.template selfadjointView<Eigen::Upper>().rankUpdate(B.transpose(), -1.0);
   gttoc(compute_L);
 
-  // Check last diagonal element - Eigen does not check it
-  if (nFrontal >= 2) {
-    int exp2, exp1;
-    // NOTE(gareth): R is already the size of A, so we don't need to add topleft here.
-    (void)frexp(R(nFrontal - 2, nFrontal - 2), &exp2);
-    (void)frexp(R(nFrontal - 1, nFrontal - 1), &exp1);
-    return (exp2 - exp1 < underconstrainedExponentDifference);
-  } else if (nFrontal == 1) {
-    int exp1;
-    (void)frexp(R(0, 0), &exp1);
-    return (exp1 > -underconstrainedExponentDifference);
-  } else {
+  return lastPivotsWellConditioned(ABC, nFrontal, topleft);
+}
+
+/* ************************************************************************* */
+bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
+  gttic(choleskyPartial);
+  if (nFrontal == 0)
+    return true;
+
+#ifdef GTSAM_USE_TBB
+  // Large frontal blocks, e.g., the root clique, are factored in parallel
+  if (nFrontal >= blockedThreshold) {
+    TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+    return choleskyPartialBlocked(ABC, nFrontal, topleft);
+  }
+#endif
+
+  return choleskyPartialDense(ABC, nFrontal, topleft);
+}
+
+/* ************************************************************************* */
+bool choleskyPartialSinglePrecision(Matrix& ABC, size_t nFrontal, size_t topleft) {
+  gttic(choleskyPartialSinglePrecision);
+  if (nFrontal == 0)
+    return true;
+
+  assert(size_t(ABC.rows()) >= topleft);
+  const size_t n = static_cast<size_t>(ABC.rows() - topleft);
+  auto active = ABC.block(topleft, topleft, n, n);
+  Eigen::MatrixXf ABCf(n, n);
+  ABCf.triangularView<Eigen::Upper>() = active.cast<float>();
+  const bool success = choleskyPartialDense(ABCf, nFrontal, 0);
+  active.triangularView<Eigen::Upper>() = ABCf.cast<double>();
+  return success;
+}
+
+/* ************************************************************************* */
+bool choleskyPartialBlocked(Matrix& ABC, size_t nFrontal, size_t topleft,
+                            size_t tileSize) {
+  gttic(choleskyPartialBlocked);
+  if (nFrontal == 0)
     return true;
+
+  assert(tileSize > 0);
+  assert(ABC.cols() == ABC.rows());
+  assert(size_t(ABC.rows()) >= topleft);
+  const size_t n = static_cast<size_t>(ABC.rows() - topleft);
+  assert(nFrontal <= size_t(n));
+
+  auto M = ABC.block(topleft, topleft, n, n);
+  for (size_t k = 0; k < nFrontal; k += tileSize) {
+    const size_t sk = std::min(tileSize, nFrontal - k), end = k + sk;
+
+    // Factor the diagonal tile, Akk = Rkk'*Rkk
+    auto Akk = M.block(k, k, sk, sk);
+    Eigen::LLT<Matrix, Eigen::Upper> llt(Akk);
+    if (llt.info() != Eigen::Success)
+      return false;
+    Akk.triangularView<Eigen::Upper>() = llt.matrixU();
+    if (end == n)
+      break;
+
+    // Row panel P = inv(Rkk') * M(k:end, end:n), one column tile at a time
+    const size_t m = n - end;
+    forEachTile(m, tileSize, [&](size_t begin, size_t last) {
+      auto P = M.block(k, end + begin, sk, last - begin);
+      Akk.triangularView<Eigen::Upper>().transpose().solveInPlace(P);
+    });
+
+    // Trailing update M(end:n, end:n) -= P'*P, on the upper triangle of tiles
+    const size_t nrTiles = (m + tileSize - 1) / tileSize;
+    std::vector<std::pair<size_t, size_t> > tiles;
+    tiles.reserve(nrTiles * (nrTiles + 1) / 2);
+    for (size_t j = 0; j < nrTiles; ++j)
+      for (size_t i = 0; i <= j; ++i)
+        tiles.push_back(std::make_pair(i, j));
+    parallelFor(tiles.size(), [&](size_t t) {
+      const size_t i0 = tiles[t].first * tileSize, j0 = tiles[t].second * tileSize;
+      const size_t ni = std::min(tileSize, m - i0), nj = std::min(tileSize, m - j0);
+      auto Pi = M.block(k, end + i0, sk, ni);
+      if (i0 == j0)
+        M.block(end + i0, end + i0, ni, ni).selfadjointView<Eigen::Upper>()
+            .rankUpdate(Pi.transpose(), -1.0);
+      else
+        M.block(end + i0, end + j0, ni, nj).noalias() -=
+            Pi.transpose() * M.block(k, end + j0, sk, nj);
+    });
+  }
+
+  return lastPivotsWellConditioned(ABC, nFrontal, topleft);
+}
+
+/* ************************************************************************* */
+void solveUpperInPlace(const Eigen::Ref<const Matrix>& R, Vector& x) {
+#ifdef GTSAM_USE_TBB
+  if (size_t(R.rows()) >= blockedThreshold)
+    return solveUpperBlockedInPlace(R, x);
+#endif
+  R.triangularView<Eigen::Upper>().solveInPlace(x);
+}
+
+/* ************************************************************************* */
+void solveUpperTransposeInPlace(const Eigen::Ref<const Matrix>& R, Vector& x) {
+#ifdef GTSAM_USE_TBB
+  if (size_t(R.rows()) >= blockedThreshold)
+    return solveUpperTransposeBlockedInPlace(R, x);
+#endif
+  R.transpose().triangularView<Eigen::Lower>().solveInPlace(x);
+}
+
+/* ************************************************************************* */
+void solveUpperBlockedInPlace(const Eigen::Ref<const Matrix>& R, Vector& x,
+                              size_t tileSize) {
+  assert(tileSize > 0);
+  assert(R.rows() == R.cols() && R.rows() == x.size());
+  const size_t n = R.rows();
+  // Back-substitute one tile at a time, from the bottom up
+  for (size_t end = n; end > 0;) {
+    const size_t begin = end > tileSize ? end - tileSize : 0, s = end - begin;
+    auto xk = x.segment(begin, s);
+    R.block(begin, begin, s, s).triangularView<Eigen::Upper>().solveInPlace(xk);
+    // Remove the solved tile from the right-hand side of the rows above
+    forEachTile(begin, tileSize, [&](size_t i0, size_t i1) {
+      x.segment(i0, i1 - i0).noalias() -= R.block(i0, begin, i1 - i0, s) * xk;
+    });
+    end = begin;
   }
 }
+
+/* ************************************************************************* */
+void solveUpperTransposeBlockedInPlace(const Eigen::Ref<const Matrix>& R,
+                                       Vector& x, size_t tileSize) {
+  assert(tileSize > 0);
+  assert(R.rows() == R.cols() && R.rows() == x.size());
+  const size_t n = R.rows();
+  // Forward-substitute one tile at a time, from the top down
+  for (size_t begin = 0; begin < n;) {
+    const size_t s = std::min(tileSize, n - begin), end = begin + s;
+    auto xk = x.segment(begin, s);
+    R.block(begin, begin, s, s).transpose().triangularView<Eigen::Lower>()
+        .solveInPlace(xk);
+    // Remove the solved tile from the right-hand side of the rows below
+    forEachTile(n - end, tileSize, [&](size_t j0, size_t j1) {
+      x.segment(end + j0, j1 - j0).noalias() -=
+          R.block(begin, end + j0, s, j1 - j0).transpose() * xk;
+    });
+    begin = end;
+  }
+}
+
 }  // namespace gtsam
@@ -62,5 +62,45 @@ GTSAM_EXPORT std::pair<size_t,bool> choleskyCareful(Matrix& ATA, int order = -1)
  */
 GTSAM_EXPORT bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft=0);
 
+/**
+ * Version of choleskyPartial that factors in single precision, for speed on
+ * hardware where float kernels are much faster.  The input and result are
+ * still stored as double, but the result is only accurate to float precision,
+ * so it is meant to be combined with iterative refinement in double.
+ */
+GTSAM_EXPORT bool choleskyPartialSinglePrecision(Matrix& ABC, size_t nFrontal,
+    size_t topleft = 0);
+
+/**
+ * Tiled version of choleskyPartial, with the same inputs and results.  The
+ * frontal block is factored one tile of \c tileSize columns at a time, and
+ * the resulting row panel solves and trailing updates are done tile by tile,
+ * in parallel if GTSAM is built with TBB.  choleskyPartial switches to this
+ * automatically for large frontal blocks, e.g., the root clique.
+ */
+GTSAM_EXPORT bool choleskyPartialBlocked(Matrix& ABC, size_t nFrontal,
+    size_t topleft = 0, size_t tileSize = 128);
+
+/**
+ * Solve R*x = b in place for an upper-triangular R, as produced by
+ * choleskyPartial.  Large systems are solved with solveUpperBlockedInPlace.
+ */
+GTSAM_EXPORT void solveUpperInPlace(const Eigen::Ref<const Matrix>& R, Vector& x);
+
+/**
+ * Solve R'*x = b in place for an upper-triangular R, as produced by
+ * choleskyPartial.  Large systems are solved with
+ * solveUpperTransposeBlockedInPlace.
+ */
+GTSAM_EXPORT void solveUpperTransposeInPlace(const Eigen::Ref<const Matrix>& R, Vector& x);
+
+/// Tiled version of solveUpperInPlace, updating the right-hand side in parallel
+GTSAM_EXPORT void solveUpperBlockedInPlace(const Eigen::Ref<const Matrix>& R,
+    Vector& x, size_t tileSize = 128);
+
+/// Tiled version of solveUpperTransposeInPlace, updating the right-hand side in parallel
+GTSAM_EXPORT void solveUpperTransposeBlockedInPlace(
+    const Eigen::Ref<const Matrix>& R, Vector& x, size_t tileSize = 128);
+
 }
 
@@ -137,6 +137,55 @@ TEST(cholesky, underconstrained) {
   LONGS_EQUAL(long(false), long(choleskyPartial(A3, 6)));
 }
 
+/* ************************************************************************* */
+TEST(cholesky, choleskyPartialBlocked) {
+  // A random symmetric positive definite matrix, factored with tiles that do
+  // not divide the frontal or separator sizes
+  const Matrix J = Matrix::Random(40, 30);
+  const Matrix ABC = J.transpose() * J + Matrix::Identity(30, 30);
+  for (size_t topleft = 0; topleft < 4; topleft += 3) {
+    Matrix expected(ABC), actual(ABC);
+    EXPECT(choleskyPartial(expected, 17, topleft));
+    EXPECT(choleskyPartialBlocked(actual, 17, topleft, 5));
+    Matrix expectedU = expected.triangularView<Eigen::Upper>();
+    Matrix actualU = actual.triangularView<Eigen::Upper>();
+    EXPECT(assert_equal(expectedU, actualU, 1e-9));
+  }
+
+  // Full factorization, and the same failures as the unblocked version
+  Matrix expected(ABC), actual(ABC);
+  EXPECT(choleskyPartial(expected, 30));
+  EXPECT(choleskyPartialBlocked(actual, 30, 0, 7));
+  Matrix expectedU = expected.triangularView<Eigen::Upper>();
+  Matrix actualU = actual.triangularView<Eigen::Upper>();
+  EXPECT(assert_equal(expectedU, actualU, 1e-9));
+
+  Matrix indefinite(ABC);
+  indefinite(20, 20) = -1.0;
+  EXPECT(!choleskyPartialBlocked(indefinite, 30, 0, 7));
+}
+
+/* ************************************************************************* */
+TEST(cholesky, solveUpperBlocked) {
+  const Matrix J = Matrix::Random(40, 30);
+  Matrix R = J.transpose() * J + Matrix::Identity(30, 30);
+  choleskyPartial(R, 30);
+  R.triangularView<Eigen::StrictlyLower>().setZero();
+  const Vector b = Vector::Random(30);
+
+  Vector x = b, xBlocked = b;
+  solveUpperInPlace(R, x);
+  solveUpperBlockedInPlace(R, xBlocked, 7);
+  EXPECT(assert_equal(b, Vector(R * x), 1e-9));
+  EXPECT(assert_equal(x, xBlocked, 1e-9));
+
+  Vector y = b, yBlocked = b;
+  solveUpperTransposeInPlace(R, y);
+  solveUpperTransposeBlockedInPlace(R, yBlocked, 7);
+  EXPECT(assert_equal(b, Vector(R.transpose() * y), 1e-9));
+  EXPECT(assert_equal(y, yBlocked, 1e-9));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -0,0 +1,127 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testConcurrentDSFVector.cpp
+ * @brief unit tests for ConcurrentDSFVector
+ */
+
+#include <gtsam/base/ConcurrentDSFVector.h>
+#include <gtsam/base/DSFVector.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/assign/std/set.hpp>
+#include <boost/assign/std/vector.hpp>
+#include <boost/random.hpp>
+using namespace boost::assign;
+
+using namespace std;
+using namespace gtsam;
+
+typedef ConcurrentDSFBase::Pair Match;
+
+/* ************************************************************************* */
+TEST(ConcurrentDSFBase, merge) {
+  ConcurrentDSFBase dsf(3);
+  EXPECT(dsf.find(0) != dsf.find(2));
+  dsf.merge(2,0);
+  EXPECT(dsf.find(0) == dsf.find(2));
+  dsf.merge(1,2);
+  EXPECT(dsf.find(0) == dsf.find(1));
+}
+
+/* ************************************************************************* */
+TEST(ConcurrentDSFBase, mergePairwiseMatches) {
+  vector<Match> matches;
+  matches += Match(2,1), Match(3,2), Match(6,5), Match(4,6);
+
+  ConcurrentDSFBase dsf(7); // We allow for keys 0..6
+  dsf.merge(matches);
+
+  // The label of each set is its smallest key
+  EXPECT_LONGS_EQUAL(1,dsf.find(1));
+  EXPECT_LONGS_EQUAL(1,dsf.find(2));
+  EXPECT_LONGS_EQUAL(1,dsf.find(3));
+  EXPECT_LONGS_EQUAL(4,dsf.find(4));
+  EXPECT_LONGS_EQUAL(4,dsf.find(5));
+  EXPECT_LONGS_EQUAL(4,dsf.find(6));
+}
+
+/* ************************************************************************* */
+TEST(ConcurrentDSFBase, sameAsDSFBase) {
+  // Random matches, enough for long chains and a few large components
+  const size_t N = 10000;
+  boost::mt19937 rng(42);
+  boost::uniform_int<size_t> uniform(0, N - 1);
+  vector<Match> matches;
+  for (size_t k = 0; k < 8000; k++)
+    matches.push_back(Match(uniform(rng), uniform(rng)));
+
+  DSFBase expected(N);
+  for(const Match& m: matches)
+    expected.merge(m.first, m.second);
+  ConcurrentDSFBase actual(N);
+  actual.merge(matches);
+
+  // Same partition, and labels are the smallest key in each set
+  for (size_t j = 0; j < N; j++) {
+    EXPECT(actual.find(j) <= j);
+    EXPECT(actual.find(actual.find(j)) == actual.find(j));
+  }
+  for(const Match& m: matches)
+    EXPECT(actual.find(m.first) == actual.find(m.second));
+  for (size_t j = 1; j < N; j++)
+    EXPECT((actual.find(j) == actual.find(j - 1)) ==
+           (expected.find(j) == expected.find(j - 1)));
+
+  // Flattening does not change the labels
+  vector<size_t> labels(N);
+  for (size_t j = 0; j < N; j++) labels[j] = actual.find(j);
+  actual.flatten();
+  for (size_t j = 0; j < N; j++) EXPECT_LONGS_EQUAL(labels[j], actual.find(j));
+}
+
+/* ************************************************************************* */
+TEST(ConcurrentDSFVector, sets) {
+  vector<size_t> keys;
+  keys += 1,2,3,4,5,6;
+  ConcurrentDSFVector dsf(keys);
+  dsf.merge(1,2);
+  dsf.merge(2,3);
+  dsf.merge(4,5);
+  dsf.merge(4,6);
+
+  map<size_t, set<size_t> > sets = dsf.sets();
+  LONGS_EQUAL(2, sets.size());
+  set<size_t> expected1; expected1 += 1,2,3;
+  EXPECT(expected1 == sets[1]);
+  EXPECT(expected1 == dsf.set(1));
+  set<size_t> expected2; expected2 += 4,5,6;
+  EXPECT(expected2 == sets[4]);
+
+  map<size_t, vector<size_t> > arrays = dsf.arrays();
+  vector<size_t> expected3; expected3 += 4,5,6;
+  EXPECT(expected3 == arrays[4]);
+}
+
+/* ************************************************************************* */
+TEST(ConcurrentDSFVector, isSingleton) {
+  ConcurrentDSFVector dsf(3);
+  dsf.merge(0,1);
+  EXPECT(!dsf.isSingleton(0));
+  EXPECT(!dsf.isSingleton(1));
+  EXPECT( dsf.isSingleton(2));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
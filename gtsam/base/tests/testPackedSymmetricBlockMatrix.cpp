@@ -0,0 +1,116 @@
+/* ----------------------------------------------------------------------------
+
+* GTSAM Copyright 2010, Georgia Tech Research Corporation,
+* Atlanta, Georgia 30332-0415
+* All Rights Reserved
+* Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+* See LICENSE for the license information
+
+* -------------------------------------------------------------------------- */
+
+/**
+* @file   testPackedSymmetricBlockMatrix.cpp
+* @brief  Unit tests for PackedSymmetricBlockMatrix class
+**/
+
+#include <CppUnitLite/TestHarness.h>
+#include <gtsam/base/PackedSymmetricBlockMatrix.h>
+#include <gtsam/base/VerticalBlockMatrix.h>
+#include <gtsam/base/ThreadsafeException.h>
+#include <gtsam/base/Testable.h>
+#include <boost/assign/list_of.hpp>
+
+using namespace std;
+using namespace gtsam;
+using boost::assign::list_of;
+
+static SymmetricBlockMatrix testBlockMatrix(
+  list_of(3)(2)(1),
+  (Matrix(6, 6) <<
+  1, 2, 3, 4, 5, 6,
+  2, 8, 9, 10, 11, 12,
+  3, 9, 15, 16, 17, 18,
+  4, 10, 16, 22, 23, 24,
+  5, 11, 17, 23, 29, 30,
+  6, 12, 18, 24, 30, 36).finished());
+
+// A positive definite augmented Hessian with blocks of size 2, 3, 1, 2 and 1
+static SymmetricBlockMatrix randomHessian() {
+  const Matrix A = Matrix::Random(12, 9);
+  return SymmetricBlockMatrix(list_of(2)(3)(1)(2)(1),
+                              Matrix(A.transpose() * A + I_9x9));
+}
+
+/* ************************************************************************* */
+TEST(PackedSymmetricBlockMatrix, ReadBlocks)
+{
+  const PackedSymmetricBlockMatrix packed(testBlockMatrix);
+  EXPECT_LONGS_EQUAL(6, packed.rows());
+  EXPECT_LONGS_EQUAL(3, packed.nBlocks());
+  EXPECT_LONGS_EQUAL(2, packed.getDim(1));
+
+  // 3*3 + 5*2 + 6*1 doubles instead of 6*6
+  EXPECT_LONGS_EQUAL(25, packed.storageSize());
+
+  for (DenseIndex i = 0; i < 3; i++)
+    for (DenseIndex j = 0; j < 3; j++)
+      EXPECT(assert_equal(testBlockMatrix.block(i, j), packed.block(i, j)));
+  EXPECT(assert_equal(Matrix(testBlockMatrix.selfadjointView()),
+                      packed.selfadjointView()));
+  EXPECT(assert_equal(Matrix(testBlockMatrix.selfadjointView()),
+                      Matrix(packed.unpack().selfadjointView())));
+}
+
+/* ************************************************************************* */
+TEST(PackedSymmetricBlockMatrix, Updates)
+{
+  SymmetricBlockMatrix expected = SymmetricBlockMatrix::LikeActiveViewOf(testBlockMatrix);
+  PackedSymmetricBlockMatrix actual(list_of(3)(2)(1));
+  expected.setZero();
+  actual.setZero();
+
+  const Matrix A1 = Matrix::Random(3, 2), A2 = Matrix::Random(2, 2);
+  expected.updateOffDiagonalBlock(0, 1, A1);
+  actual.updateOffDiagonalBlock(0, 1, A1);
+  expected.updateOffDiagonalBlock(2, 0, A1.col(0).transpose());
+  actual.updateOffDiagonalBlock(2, 0, A1.col(0).transpose());
+  expected.updateDiagonalBlock(1, A2);
+  actual.updateDiagonalBlock(1, A2);
+  expected.negate();
+  actual.negate();
+  EXPECT(assert_equal(Matrix(expected.selfadjointView()), actual.selfadjointView()));
+
+  const Vector x = Vector::Random(6);
+  EXPECT(assert_equal(Vector(expected.selfadjointView() * x), actual.multiply(x)));
+}
+
+/* ************************************************************************* */
+TEST(PackedSymmetricBlockMatrix, choleskyPartialAndSplit)
+{
+  SymmetricBlockMatrix expected = randomHessian();
+  PackedSymmetricBlockMatrix actual(expected);
+
+  expected.choleskyPartial(2);
+  actual.choleskyPartial(2);
+  const VerticalBlockMatrix expectedRSd = expected.split(2);
+  const VerticalBlockMatrix actualRSd = actual.split(2);
+  EXPECT(assert_equal(Matrix(expectedRSd.full()), Matrix(actualRSd.full()), 1e-9));
+
+  // The remaining active view is the factor on the separator
+  EXPECT_LONGS_EQUAL(3, actual.nBlocks());
+  EXPECT(assert_equal(Matrix(expected.selfadjointView()), actual.selfadjointView(), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(PackedSymmetricBlockMatrix, choleskyFailed)
+{
+  SymmetricBlockMatrix hessian = randomHessian();
+  hessian.setDiagonalBlock(1, -I_3x3);
+  PackedSymmetricBlockMatrix packed(hessian);
+  CHECK_EXCEPTION(packed.choleskyPartial(3), CholeskyFailed);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -0,0 +1,345 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BatchCamera.cpp
+ * @brief   Batched projection, backprojection and (un)calibration of point arrays
+ */
+
+#include <gtsam/geometry/BatchCamera.h>
+#include <gtsam/base/LaneMatrix.h>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+namespace batch {
+
+using namespace internal;
+
+namespace {
+
+typedef LaneMatrix<2, 2> Lanes22;
+
+// Load x and y of a block of 2D points
+void loadBlock(const Point2s& points, size_t i, Lanes* x, Lanes* y) {
+  const size_t n = points.size();
+  for (int k = 0; k < kLaneWidth; k++) {
+    const Point2& p = points[laneIndex(i, k, n)];
+    (*x)(k) = p.x();
+    (*y)(k) = p.y();
+  }
+}
+
+void storeBlock(const Lanes& x, const Lanes& y, size_t i, Point2s* points) {
+  for (size_t k = 0; k < lanesUsed(i, points->size()); k++)
+    (*points)[i + k] = Point2(x(k), y(k));
+}
+
+template <int M, int N, class MATRICES>
+void storeJacobian(const LaneMatrix<M, N>& H, size_t i, MATRICES* Hs) {
+  for (size_t k = 0; k < lanesUsed(i, Hs->size()); k++)
+    (*Hs)[i + k] = H.lane(k);
+}
+
+// The distortion model of Cal3DS2_Base, for a block of points
+struct DistortionLanes {
+  Lanes xx, yy, xy, rr, r4, g, dx, dy;
+
+  DistortionLanes(const Cal3DS2_Base& K, const Lanes& x, const Lanes& y)
+      : xx(x * x), yy(y * y), xy(x * y), rr(xx + yy), r4(rr * rr),
+        g(1. + K.k1() * rr + K.k2() * r4),
+        dx(2. * K.p1() * xy + K.p2() * (rr + 2. * xx)),
+        dy(2. * K.p2() * xy + K.p1() * (rr + 2. * yy)) {}
+};
+
+// Cal3DS2_Base::uncalibrate on a block of points, see there for the formulas
+void uncalibrateLanes(const Cal3DS2_Base& K, const Lanes& x, const Lanes& y,
+                      Lanes* u, Lanes* v, LaneMatrix<2, 9>* Dcal,
+                      Lanes22* Dp) {
+  const DistortionLanes d(K, x, y);
+  const Lanes pnx = d.g * x + d.dx;
+  const Lanes pny = d.g * y + d.dy;
+  *u = K.fx() * pnx + K.skew() * pny + K.px();
+  *v = K.fy() * pny + K.py();
+
+  if (Dcal) {
+    // [DR1, DK * DR2]
+    LaneMatrix<2, 9>& D = *Dcal;
+    D(0, 0) = pnx; D(0, 1).setZero(); D(0, 2) = pny; D(0, 3).setOnes(); D(0, 4).setZero();
+    D(1, 0).setZero(); D(1, 1) = pny; D(1, 2).setZero(); D(1, 3).setZero(); D(1, 4).setOnes();
+    const Lanes DR2[2][4] = {
+        {x * d.rr, x * d.r4, 2. * d.xy, d.rr + 2. * d.xx},
+        {y * d.rr, y * d.r4, d.rr + 2. * d.yy, 2. * d.xy}};
+    for (int j = 0; j < 4; j++) {
+      D(0, 5 + j) = K.fx() * DR2[0][j] + K.skew() * DR2[1][j];
+      D(1, 5 + j) = K.fy() * DR2[1][j];
+    }
+  }
+
+  if (Dp) {
+    const Lanes drdx = 2. * x, drdy = 2. * y;
+    const Lanes dgdx = K.k1() * drdx + K.k2() * 2. * d.rr * drdx;
+    const Lanes dgdy = K.k1() * drdy + K.k2() * 2. * d.rr * drdy;
+    const Lanes dDxdx = 2. * K.p1() * y + K.p2() * (drdx + 4. * x);
+    const Lanes dDxdy = 2. * K.p1() * x + K.p2() * drdy;
+    const Lanes dDydx = 2. * K.p2() * y + K.p1() * drdx;
+    const Lanes dDydy = 2. * K.p2() * x + K.p1() * (drdy + 4. * y);
+    const Lanes DR00 = d.g + x * dgdx + dDxdx, DR01 = x * dgdy + dDxdy;
+    const Lanes DR10 = y * dgdx + dDydx, DR11 = d.g + y * dgdy + dDydy;
+    (*Dp)(0, 0) = K.fx() * DR00 + K.skew() * DR10;
+    (*Dp)(0, 1) = K.fx() * DR01 + K.skew() * DR11;
+    (*Dp)(1, 0) = K.fy() * DR10;
+    (*Dp)(1, 1) = K.fy() * DR11;
+  }
+}
+
+// Cal3DS2_Base::calibrate on a block of points, with the same iteration
+void calibrateLanes(const Cal3DS2_Base& K, const Lanes& u, const Lanes& v,
+                    double tol, Lanes* x, Lanes* y) {
+  const Lanes invKPix = (1 / K.fx()) * (u - K.px() - (K.skew() / K.fy()) * (v - K.py()));
+  const Lanes invKPiy = (1 / K.fy()) * (v - K.py());
+
+  // initialize by ignoring the distortion, and iterate until all lanes are
+  // close to the actual pixel coordinates
+  *x = invKPix;
+  *y = invKPiy;
+  LaneMask done = LaneMask::Constant(false);
+  const int maxIterations = 10;
+  for (int iteration = 0; iteration < maxIterations; ++iteration) {
+    Lanes ux, uy;
+    uncalibrateLanes(K, *x, *y, &ux, &uy, 0, 0);
+    done = done || ((ux - u).square() + (uy - v).square()).sqrt() <= tol;
+    if (done.all()) return;
+    const DistortionLanes d(K, *x, *y);
+    *x = done.select(*x, (invKPix - d.dx) / d.g);
+    *y = done.select(*y, (invKPiy - d.dy) / d.g);
+  }
+  throw std::runtime_error(
+      "Cal3DS2::calibrate fails to converge. need a better initialization");
+}
+
+} // namespace
+
+/* ************************************************************************* */
+void project(const Pose3& pose, const Point3s& points, Point2s* pn,
+             Matrix26s* Dpose, Matrix23s* Dpoint, vector<bool>* inFront) {
+  const size_t n = points.size();
+  pn->resize(n);
+  if (Dpose) Dpose->resize(n);
+  if (Dpoint) Dpoint->resize(n);
+  if (inFront) inFront->resize(n);
+
+  const Matrix3 Rt = pose.rotation().transpose();
+  const Point3& t = pose.translation();
+  for (size_t i = 0; i < n; i += kLaneWidth) {
+    // Transform to camera coordinates, q = R' * (p - t)
+    Lanes p[3];
+    for (int k = 0; k < kLaneWidth; k++) {
+      const Point3& point = points[laneIndex(i, k, n)];
+      for (int j = 0; j < 3; j++) p[j](k) = point(j) - t(j);
+    }
+    Lanes q[3];
+    for (int r = 0; r < 3; r++)
+      q[r] = Rt(r, 0) * p[0] + Rt(r, 1) * p[1] + Rt(r, 2) * p[2];
+
+    const Lanes d = q[2].inverse();
+    const Lanes u = q[0] * d, v = q[1] * d;
+    storeBlock(u, v, i, pn);
+    if (inFront)
+      for (size_t k = 0; k < lanesUsed(i, n); k++)
+        (*inFront)[i + k] = q[2](k) > 0;
+
+    // Same as PinholeBase::Dpose and PinholeBase::Dpoint
+    if (Dpose) {
+      const Lanes uv = u * v;
+      LaneMatrix<2, 6> H;
+      H(0, 0) = uv; H(0, 1) = -1. - u * u; H(0, 2) = v;
+      H(0, 3) = -d; H(0, 4).setZero(); H(0, 5) = d * u;
+      H(1, 0) = 1. + v * v; H(1, 1) = -uv; H(1, 2) = -u;
+      H(1, 3).setZero(); H(1, 4) = -d; H(1, 5) = d * v;
+      storeJacobian(H, i, Dpose);
+    }
+    if (Dpoint) {
+      LaneMatrix<2, 3> H;
+      for (int c = 0; c < 3; c++) {
+        H(0, c) = d * (Rt(0, c) - u * Rt(2, c));
+        H(1, c) = d * (Rt(1, c) - v * Rt(2, c));
+      }
+      storeJacobian(H, i, Dpoint);
+    }
+  }
+}
+
+/* ************************************************************************* */
+void backproject(const Pose3& pose, const Point2s& pn,
+                 const vector<double>& depths, Point3s* points) {
+  if (pn.size() != depths.size())
+    throw invalid_argument("batch::backproject: input sizes do not match");
+  const size_t n = pn.size();
+  points->resize(n);
+
+  const Matrix3 R = pose.rotation().matrix();
+  const Point3& t = pose.translation();
+  for (size_t i = 0; i < n; i += kLaneWidth) {
+    Lanes x, y, depth;
+    loadBlock(pn, i, &x, &y);
+    for (int k = 0; k < kLaneWidth; k++) depth(k) = depths[laneIndex(i, k, n)];
+
+    // p = R * [x*depth, y*depth, depth] + t
+    const Lanes qx = x * depth, qy = y * depth;
+    Lanes p[3];
+    for (int r = 0; r < 3; r++)
+      p[r] = R(r, 0) * qx + R(r, 1) * qy + R(r, 2) * depth + t(r);
+    for (size_t k = 0; k < lanesUsed(i, n); k++)
+      (*points)[i + k] = Point3(p[0](k), p[1](k), p[2](k));
+  }
+}
+
+/* ************************************************************************* */
+void uncalibrate(const Cal3_S2& K, const Point2s& pn, Point2s* pi,
+                 Matrix2Ds<5>* Dcal, Matrix2s* Dp) {
+  const size_t n = pn.size();
+  pi->resize(n);
+  if (Dcal) Dcal->resize(n);
+  for (size_t i = 0; i < n; i += kLaneWidth) {
+    Lanes x, y;
+    loadBlock(pn, i, &x, &y);
+    storeBlock(K.fx() * x + K.skew() * y + K.px(), K.fy() * y + K.py(), i, pi);
+    if (Dcal) {
+      LaneMatrix<2, 5> H;
+      H.setZero();
+      H(0, 0) = x; H(0, 2) = y; H(0, 3).setOnes();
+      H(1, 1) = y; H(1, 4).setOnes();
+      storeJacobian(H, i, Dcal);
+    }
+  }
+  if (Dp) {
+    Matrix2 DK;
+    DK << K.fx(), K.skew(), 0.0, K.fy();
+    Dp->assign(n, DK);
+  }
+}
+
+/* ************************************************************************* */
+void uncalibrate(const Cal3DS2_Base& K, const Point2s& pn, Point2s* pi,
+                 Matrix2Ds<9>* Dcal, Matrix2s* Dp) {
+  const size_t n = pn.size();
+  pi->resize(n);
+  if (Dcal) Dcal->resize(n);
+  if (Dp) Dp->resize(n);
+  for (size_t i = 0; i < n; i += kLaneWidth) {
+    Lanes x, y, u, v;
+    loadBlock(pn, i, &x, &y);
+    LaneMatrix<2, 9> H1;
+    Lanes22 H2;
+    uncalibrateLanes(K, x, y, &u, &v, Dcal ? &H1 : 0, Dp ? &H2 : 0);
+    storeBlock(u, v, i, pi);
+    if (Dcal) storeJacobian(H1, i, Dcal);
+    if (Dp) storeJacobian(H2, i, Dp);
+  }
+}
+
+/* ************************************************************************* */
+void uncalibrate(const Cal3Unified& K, const Point2s& pn, Point2s* pi,
+                 Matrix2Ds<10>* Dcal, Matrix2s* Dp) {
+  const size_t n = pn.size();
+  pi->resize(n);
+  if (Dcal) Dcal->resize(n);
+  if (Dp) Dp->resize(n);
+  const double xi = K.xi();
+  for (size_t i = 0; i < n; i += kLaneWidth) {
+    Lanes xs, ys, u, v;
+    loadBlock(pn, i, &xs, &ys);
+
+    // Project to the normalized plane, then distort as Cal3DS2
+    const Lanes sqrt_nx = (xs * xs + ys * ys + 1.0).sqrt();
+    const Lanes xi_sqrt_nx = (1.0 + xi * sqrt_nx).inverse();
+    const Lanes xi_sqrt_nx2 = xi_sqrt_nx * xi_sqrt_nx;
+    LaneMatrix<2, 9> H1base;
+    Lanes22 H2base;
+    uncalibrateLanes(K, xs * xi_sqrt_nx, ys * xi_sqrt_nx, &u, &v,
+                     Dcal ? &H1base : 0, Dcal || Dp ? &H2base : 0);
+    storeBlock(u, v, i, pi);
+
+    // Same derivatives as Cal3Unified::uncalibrate
+    if (Dcal) {
+      const Lanes DU0 = -xs * sqrt_nx * xi_sqrt_nx2;
+      const Lanes DU1 = -ys * sqrt_nx * xi_sqrt_nx2;
+      LaneMatrix<2, 10> H1;
+      for (int r = 0; r < 2; r++) {
+        for (int c = 0; c < 9; c++) H1(r, c) = H1base(r, c);
+        H1(r, 9) = H2base(r, 0) * DU0 + H2base(r, 1) * DU1;
+      }
+      storeJacobian(H1, i, Dcal);
+    }
+    if (Dp) {
+      const Lanes denom = xi_sqrt_nx2 / sqrt_nx;
+      const Lanes mid = -(xi * xs * ys) * denom;
+      Lanes22 DU;
+      DU(0, 0) = (sqrt_nx + xi * (ys * ys + 1.0)) * denom;
+      DU(0, 1) = mid;
+      DU(1, 0) = mid;
+      DU(1, 1) = (sqrt_nx + xi * (xs * xs + 1.0)) * denom;
+      storeJacobian(H2base * DU, i, Dp);
+    }
+  }
+}
+
+/* ************************************************************************* */
+void calibrate(const Cal3_S2& K, const Point2s& pi, Point2s* pn) {
+  const size_t n = pi.size();
+  pn->resize(n);
+  const double inv_fx = 1 / K.fx(), inv_fy = 1 / K.fy();
+  for (size_t i = 0; i < n; i += kLaneWidth) {
+    Lanes u, v;
+    loadBlock(pi, i, &u, &v);
+    const Lanes inv_fy_delta_v = inv_fy * (v - K.py());
+    storeBlock(inv_fx * (u - K.px() - K.skew() * inv_fy_delta_v),
+               inv_fy_delta_v, i, pn);
+  }
+}
+
+/* ************************************************************************* */
+void calibrate(const Cal3DS2_Base& K, const Point2s& pi, Point2s* pn,
+               double tol) {
+  const size_t n = pi.size();
+  pn->resize(n);
+  for (size_t i = 0; i < n; i += kLaneWidth) {
+    Lanes u, v, x, y;
+    loadBlock(pi, i, &u, &v);
+    calibrateLanes(K, u, v, tol, &x, &y);
+    storeBlock(x, y, i, pn);
+  }
+}
+
+/* ************************************************************************* */
+void calibrate(const Cal3Unified& K, const Point2s& pi, Point2s* pn,
+               double tol) {
+  const size_t n = pi.size();
+  pn->resize(n);
+  const double xi = K.xi();
+  for (size_t i = 0; i < n; i += kLaneWidth) {
+    Lanes u, v, x, y;
+    loadBlock(pi, i, &u, &v);
+    calibrateLanes(K, u, v, tol, &x, &y);
+
+    // Same as Cal3Unified::nPlaneToSpace
+    const Lanes xy2 = x * x + y * y;
+    const Lanes sq_xy = (xi + (1.0 + (1 - xi * xi) * xy2).sqrt()) / (xy2 + 1.0);
+    const Lanes scale = sq_xy / (sq_xy - xi);
+    storeBlock(scale * x, scale * y, i, pn);
+  }
+}
+
+} // namespace batch
+} // namespace gtsam
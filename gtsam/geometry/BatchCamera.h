@@ -0,0 +1,156 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BatchCamera.h
+ * @brief   Batched projection, backprojection and (un)calibration of point arrays
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Cal3DS2_Base.h>
+#include <gtsam/geometry/Cal3Unified.h>
+#include <gtsam/geometry/CameraSet.h>
+#include <gtsam/geometry/PinholeCamera.h>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Batched versions of camera projection and calibration, in the same style as
+ * BatchPose3.h: points are processed in blocks of internal::kLaneWidth in
+ * structure-of-arrays form, so the kernels vectorize across points. Results are
+ * identical to the single-point calls up to floating point round-off.
+ *
+ * Unlike PinholeBase::project2, the batched projections never throw a
+ * CheiralityException, as one point behind the camera should not invalidate a
+ * whole batch. Pass \c inFront to find out which points have positive depth.
+ */
+namespace batch {
+
+typedef std::vector<Point2, Eigen::aligned_allocator<Point2> > Point2s;
+typedef std::vector<Point3> Point3s;
+typedef std::vector<Matrix2, Eigen::aligned_allocator<Matrix2> > Matrix2s;
+typedef std::vector<Matrix23, Eigen::aligned_allocator<Matrix23> > Matrix23s;
+
+/// Array of 2*D Jacobians
+template <int D>
+using Matrix2Ds = std::vector<Eigen::Matrix<double, 2, D>,
+                              Eigen::aligned_allocator<Eigen::Matrix<double, 2, D> > >;
+
+typedef Matrix2Ds<6> Matrix26s;
+
+/// @name Calibrated cameras
+/// @{
+
+/// pn[i] = PinholeBase(pose).project2(points[i], Dpose[i], Dpoint[i])
+GTSAM_EXPORT void project(const Pose3& pose, const Point3s& points, Point2s* pn,
+                          Matrix26s* Dpose = 0, Matrix23s* Dpoint = 0,
+                          std::vector<bool>* inFront = 0);
+
+/// points[i] = pose.transformFrom(PinholeBase::BackprojectFromCamera(pn[i], depths[i]))
+GTSAM_EXPORT void backproject(const Pose3& pose, const Point2s& pn,
+                              const std::vector<double>& depths, Point3s* points);
+
+/// @}
+/// @name Calibrations
+/// @{
+
+/// pi[i] = K.uncalibrate(pn[i], Dcal[i], Dp[i])
+GTSAM_EXPORT void uncalibrate(const Cal3_S2& K, const Point2s& pn, Point2s* pi,
+                              Matrix2Ds<5>* Dcal = 0, Matrix2s* Dp = 0);
+
+/// pi[i] = K.uncalibrate(pn[i], Dcal[i], Dp[i])
+GTSAM_EXPORT void uncalibrate(const Cal3DS2_Base& K, const Point2s& pn, Point2s* pi,
+                              Matrix2Ds<9>* Dcal = 0, Matrix2s* Dp = 0);
+
+/// pi[i] = K.uncalibrate(pn[i], Dcal[i], Dp[i])
+GTSAM_EXPORT void uncalibrate(const Cal3Unified& K, const Point2s& pn, Point2s* pi,
+                              Matrix2Ds<10>* Dcal = 0, Matrix2s* Dp = 0);
+
+/// pn[i] = K.calibrate(pi[i])
+GTSAM_EXPORT void calibrate(const Cal3_S2& K, const Point2s& pi, Point2s* pn);
+
+/**
+ * pn[i] = K.calibrate(pi[i], tol), with the same fixed point iteration, run on
+ * all lanes of a block until each of them has converged.
+ * Throws std::runtime_error if any point fails to converge.
+ */
+GTSAM_EXPORT void calibrate(const Cal3DS2_Base& K, const Point2s& pi, Point2s* pn,
+                            double tol = 1e-5);
+
+/// pn[i] = K.calibrate(pi[i], tol)
+GTSAM_EXPORT void calibrate(const Cal3Unified& K, const Point2s& pi, Point2s* pn,
+                            double tol = 1e-5);
+
+/// @}
+/// @name Uncalibrated cameras
+/// @{
+
+/**
+ * pi[i] = camera.project2(points[i], Dcamera[i], Dpoint[i]), for all
+ * calibrations with a batched uncalibrate above.
+ */
+template <class CALIBRATION>
+void project(const PinholeCamera<CALIBRATION>& camera, const Point3s& points,
+             Point2s* pi,
+             Matrix2Ds<6 + FixedDimension<CALIBRATION>::value>* Dcamera = 0,
+             Matrix23s* Dpoint = 0, std::vector<bool>* inFront = 0) {
+  static const int DimK = FixedDimension<CALIBRATION>::value;
+  Point2s pn;
+  Matrix26s Dpose;
+  project(camera.pose(), points, &pn, Dcamera ? &Dpose : 0, Dpoint, inFront);
+
+  Matrix2Ds<DimK> Dcal;
+  Matrix2s Dpi_pn;
+  uncalibrate(camera.calibration(), pn, pi, Dcamera ? &Dcal : 0,
+              Dcamera || Dpoint ? &Dpi_pn : 0);
+
+  // Apply the chain rule
+  if (Dcamera) {
+    Dcamera->resize(points.size());
+    for (size_t i = 0; i < points.size(); i++)
+      (*Dcamera)[i] << Dpi_pn[i] * Dpose[i], Dcal[i];
+  }
+  if (Dpoint)
+    for (size_t i = 0; i < points.size(); i++)
+      (*Dpoint)[i] = Dpi_pn[i] * (*Dpoint)[i];
+}
+
+/// points[i] = camera.backproject(pi[i], depths[i])
+template <class CALIBRATION>
+void backproject(const PinholeCamera<CALIBRATION>& camera, const Point2s& pi,
+                 const std::vector<double>& depths, Point3s* points) {
+  Point2s pn;
+  calibrate(camera.calibration(), pi, &pn);
+  backproject(camera.pose(), pn, depths, points);
+}
+
+/**
+ * Project many points into every camera of a CameraSet: z[j][i] is the
+ * projection of points[i] into cameras[j].
+ */
+template <class CALIBRATION>
+void project(const CameraSet<PinholeCamera<CALIBRATION> >& cameras,
+             const Point3s& points, std::vector<Point2s>* z,
+             std::vector<std::vector<bool> >* inFront = 0) {
+  z->resize(cameras.size());
+  if (inFront) inFront->resize(cameras.size());
+  for (size_t j = 0; j < cameras.size(); j++)
+    project(cameras[j], points, &(*z)[j], 0, 0, inFront ? &(*inFront)[j] : 0);
+}
+
+/// @}
+
+} // namespace batch
+} // namespace gtsam
@@ -0,0 +1,211 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BatchPose3.cpp
+ * @brief   Batched Rot3/Pose3 operations over arrays, with optional Jacobians
+ */
+
+#include <gtsam/geometry/BatchPose3.h>
+#include <gtsam/base/LaneMatrix.h>
+
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+namespace batch {
+
+using namespace internal;
+
+namespace {
+
+void checkSizes(size_t a, size_t b, const char* function) {
+  if (a != b)
+    throw invalid_argument(string(function) + ": input sizes do not match");
+}
+
+// Load rotations and translations of a block of poses
+void loadBlock(const Pose3s& poses, size_t i, Lanes33* R, Lanes3* t) {
+  const size_t n = poses.size();
+  for (int k = 0; k < kLaneWidth; k++) {
+    const Pose3& pose = poses[laneIndex(i, k, n)];
+    R->setLane(k, pose.rotation().matrix());
+    t->setLane(k, pose.translation());
+  }
+}
+
+// Store a block of poses, skipping padded lanes
+void storeBlock(const Lanes33& R, const Lanes3& t, size_t i, Pose3s* poses) {
+  for (size_t k = 0; k < lanesUsed(i, poses->size()); k++)
+    (*poses)[i + k] = Pose3(Rot3(R.lane(k)), Point3(t.lane(k)));
+}
+
+// Store the adjoint-like 6*6 Jacobian sign*[A 0; B A] of a block
+void storeJacobian(const Lanes33& A, const Lanes33& B, double sign, size_t i,
+                   Matrix6s* H) {
+  for (size_t k = 0; k < lanesUsed(i, H->size()); k++) {
+    Matrix6& Hk = (*H)[i + k];
+    const Matrix3 Ak = sign * A.lane(k);
+    Hk << Ak, Z_3x3, sign * B.lane(k), Ak;
+  }
+}
+
+void storeIdentity(size_t i, Matrix6s* H) {
+  for (size_t k = 0; k < lanesUsed(i, H->size()); k++)
+    (*H)[i + k].setIdentity();
+}
+
+// -[R]^T [t]x, the lower-left block of the adjoint map of (R, t)^{-1}
+Lanes33 minusTransposeSkew(const Lanes33& R, const Lanes3& t) {
+  Lanes33 B = transposeMultiply(R, skew(t));
+  for (int r = 0; r < 3; r++)
+    for (int c = 0; c < 3; c++) B(r, c) = -B(r, c);
+  return B;
+}
+
+Lanes33 transpose(const Lanes33& R) {
+  Lanes33 Rt;
+  for (int r = 0; r < 3; r++)
+    for (int c = 0; c < 3; c++) Rt(r, c) = R(c, r);
+  return Rt;
+}
+
+} // namespace
+
+/* ************************************************************************* */
+void Expmap(const Vector3s& omega, Rot3s* R, Matrix3s* H) {
+  const size_t n = omega.size();
+  R->resize(n);
+  if (H) H->resize(n);
+
+  for (size_t i = 0; i < n; i += kLaneWidth) {
+    Lanes3 w;
+    for (int k = 0; k < kLaneWidth; k++)
+      w.setLane(k, omega[laneIndex(i, k, n)]);
+
+    // Same branches as so3::ExpmapFunctor, selected per lane
+    const Lanes theta2 = w(0, 0).square() + w(1, 0).square() + w(2, 0).square();
+    const LaneMask nearZero = theta2 <= numeric_limits<double>::epsilon();
+    const Lanes theta = nearZero.select(Lanes::Ones(), theta2.sqrt());
+    const Lanes sin_theta = theta.sin();
+    const Lanes s2 = (0.5 * theta).sin();
+    const Lanes one_minus_cos = 2.0 * s2 * s2;
+
+    const Lanes33 W = skew(w);
+    Lanes33 K;
+    for (int r = 0; r < 3; r++)
+      for (int c = 0; c < 3; c++) K(r, c) = W(r, c) / theta;
+    const Lanes33 KK = K * K;
+
+    // R = I + W near zero, I + sin(theta) K + (1 - cos(theta)) KK otherwise
+    Lanes33 Rl;
+    Rl.setIdentity();
+    for (int r = 0; r < 3; r++)
+      for (int c = 0; c < 3; c++)
+        Rl(r, c) += nearZero.select(W(r, c),
+            sin_theta * K(r, c) + one_minus_cos * KK(r, c));
+    for (size_t k = 0; k < lanesUsed(i, n); k++)
+      (*R)[i + k] = Rot3(Rl.lane(k));
+
+    if (H) {
+      // dexp = I - 0.5 W near zero, I - a K + b KK otherwise
+      const Lanes a = one_minus_cos / theta;
+      const Lanes b = 1.0 - sin_theta / theta;
+      Lanes33 D;
+      D.setIdentity();
+      for (int r = 0; r < 3; r++)
+        for (int c = 0; c < 3; c++)
+          D(r, c) += nearZero.select(-0.5 * W(r, c),
+              b * KK(r, c) - a * K(r, c));
+      for (size_t k = 0; k < lanesUsed(i, n); k++)
+        (*H)[i + k] = D.lane(k);
+    }
+  }
+}
+
+/* ************************************************************************* */
+void compose(const Pose3s& a, const Pose3s& b, Pose3s* ab, Matrix6s* Ha,
+             Matrix6s* Hb) {
+  checkSizes(a.size(), b.size(), "batch::compose");
+  const size_t n = a.size();
+  ab->resize(n);
+  if (Ha) Ha->resize(n);
+  if (Hb) Hb->resize(n);
+
+  for (size_t i = 0; i < n; i += kLaneWidth) {
+    Lanes33 Ra, Rb;
+    Lanes3 ta, tb;
+    loadBlock(a, i, &Ra, &ta);
+    loadBlock(b, i, &Rb, &tb);
+
+    // (Ra, ta) * (Rb, tb) = (Ra Rb, Ra tb + ta)
+    Lanes3 t = Ra * tb;
+    for (int r = 0; r < 3; r++) t(r, 0) += ta(r, 0);
+    storeBlock(Ra * Rb, t, i, ab);
+
+    // Ha = AdjointMap(b^{-1}), Hb = I
+    if (Ha) storeJacobian(transpose(Rb), minusTransposeSkew(Rb, tb), 1.0, i, Ha);
+    if (Hb) storeIdentity(i, Hb);
+  }
+}
+
+/* ************************************************************************* */
+void between(const Pose3s& a, const Pose3s& b, Pose3s* ab, Matrix6s* Ha,
+             Matrix6s* Hb) {
+  checkSizes(a.size(), b.size(), "batch::between");
+  const size_t n = a.size();
+  ab->resize(n);
+  if (Ha) Ha->resize(n);
+  if (Hb) Hb->resize(n);
+
+  for (size_t i = 0; i < n; i += kLaneWidth) {
+    Lanes33 Ra, Rb;
+    Lanes3 ta, tb;
+    loadBlock(a, i, &Ra, &ta);
+    loadBlock(b, i, &Rb, &tb);
+
+    // (Ra, ta)^{-1} * (Rb, tb) = (Ra^T Rb, Ra^T (tb - ta))
+    Lanes3 d;
+    for (int r = 0; r < 3; r++) d(r, 0) = tb(r, 0) - ta(r, 0);
+    const Lanes33 R = transposeMultiply(Ra, Rb);
+    const Lanes3 t = transposeMultiply(Ra, d);
+    storeBlock(R, t, i, ab);
+
+    // Ha = -AdjointMap(ab^{-1}), Hb = I
+    if (Ha) storeJacobian(transpose(R), minusTransposeSkew(R, t), -1.0, i, Ha);
+    if (Hb) storeIdentity(i, Hb);
+  }
+}
+
+/* ************************************************************************* */
+void retract(const Pose3s& poses, const Vector6s& xi, Pose3s* result) {
+  checkSizes(poses.size(), xi.size(), "batch::retract");
+  Pose3s increments;
+  increments.reserve(xi.size());
+  for (const Vector6& v : xi)
+    increments.push_back(Pose3::ChartAtOrigin::Retract(v));
+  compose(poses, increments, result);
+}
+
+/* ************************************************************************* */
+void localCoordinates(const Pose3s& a, const Pose3s& b, Vector6s* result) {
+  checkSizes(a.size(), b.size(), "batch::localCoordinates");
+  Pose3s deltas;
+  between(a, b, &deltas);
+  result->resize(deltas.size());
+  for (size_t i = 0; i < deltas.size(); i++)
+    (*result)[i] = Pose3::ChartAtOrigin::Local(deltas[i]);
+}
+
+} // namespace batch
+} // namespace gtsam
@@ -0,0 +1,64 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BatchPose3.h
+ * @brief   Batched Rot3/Pose3 operations over arrays, with optional Jacobians
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Pose3.h>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Batched versions of the most frequently called Rot3 and Pose3 operations.
+ * The inputs are processed in blocks of internal::kLaneWidth elements, stored
+ * in structure-of-arrays form, so the kernels are branch-free and vectorize
+ * across elements. Results are identical to the corresponding single-element
+ * calls up to floating point round-off.
+ *
+ * All output arguments are resized to the number of inputs, and Jacobians are
+ * only computed if the corresponding pointer is non-null.
+ */
+namespace batch {
+
+typedef std::vector<Vector3> Vector3s;
+typedef std::vector<Vector6, Eigen::aligned_allocator<Vector6> > Vector6s;
+typedef std::vector<Matrix3> Matrix3s;
+typedef std::vector<Matrix6, Eigen::aligned_allocator<Matrix6> > Matrix6s;
+typedef std::vector<Rot3, Eigen::aligned_allocator<Rot3> > Rot3s;
+typedef std::vector<Pose3, Eigen::aligned_allocator<Pose3> > Pose3s;
+
+/// R[i] = Rot3::Expmap(omega[i]), with H[i] its derivative
+GTSAM_EXPORT void Expmap(const Vector3s& omega, Rot3s* R, Matrix3s* H = 0);
+
+/// ab[i] = a[i].compose(b[i], Ha[i], Hb[i])
+GTSAM_EXPORT void compose(const Pose3s& a, const Pose3s& b, Pose3s* ab,
+                          Matrix6s* Ha = 0, Matrix6s* Hb = 0);
+
+/// ab[i] = a[i].between(b[i], Ha[i], Hb[i])
+GTSAM_EXPORT void between(const Pose3s& a, const Pose3s& b, Pose3s* ab,
+                          Matrix6s* Ha = 0, Matrix6s* Hb = 0);
+
+/// result[i] = poses[i].retract(xi[i])
+GTSAM_EXPORT void retract(const Pose3s& poses, const Vector6s& xi,
+                          Pose3s* result);
+
+/// result[i] = a[i].localCoordinates(b[i])
+GTSAM_EXPORT void localCoordinates(const Pose3s& a, const Pose3s& b,
+                                   Vector6s* result);
+
+} // namespace batch
+} // namespace gtsam
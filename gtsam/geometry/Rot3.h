@@ -314,11 +314,12 @@ namespace gtsam {
      * \f$ [R_x,R_y,R_z] \f$ using Rodrigues' formula
      */
     static Rot3 Expmap(const Vector3& v, OptionalJacobian<3,3> H = boost::none) {
-      if(H) *H = Rot3::ExpmapDerivative(v);
 #ifdef GTSAM_USE_QUATERNIONS
+      if(H) *H = Rot3::ExpmapDerivative(v);
       return traits<gtsam::Quaternion>::Expmap(v);
 #else
-      return Rot3(traits<SO3>::Expmap(v));
+      // SO3::Expmap shares sin/cos between the value and its derivative
+      return Rot3(SO3::Expmap(v, H));
 #endif
     }
 
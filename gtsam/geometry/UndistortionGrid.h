@@ -0,0 +1,109 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    UndistortionGrid.h
+ * @brief   Precomputed lookup grid to speed up calibrate() of distorted cameras
+ */
+
+#pragma once
+
+#include <gtsam/geometry/BatchCamera.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Lookup grid that speeds up calibrate() of calibrations whose inverse has no
+ * closed form, e.g., Cal3DS2 and Cal3Unified, which otherwise run a fixed point
+ * iteration on every call.
+ *
+ * On construction, the intrinsic coordinates of the nodes of a regular grid over
+ * the image [0,width]*[0,height] are computed once. calibrate() then interpolates
+ * bilinearly between the nodes of the cell containing the pixel, and polishes the
+ * result with \c refinements Newton steps on uncalibrate(), which converge
+ * quadratically from such a close initial estimate. Pixels outside the image fall
+ * back to CALIBRATION::calibrate.
+ *
+ * Construction throws std::runtime_error if calibrate() fails for a grid node,
+ * i.e., if the distortion cannot be inverted over the whole image.
+ */
+template <class CALIBRATION>
+class UndistortionGrid {
+  CALIBRATION K_;
+  double width_, height_, cellSize_;
+  size_t cols_, rows_;  ///< number of nodes in each direction
+  size_t refinements_;
+  batch::Point2s nodes_;  ///< intrinsic coordinates, row-major
+
+ public:
+  /**
+   * Constructor
+   * @param K the calibration
+   * @param width, height image size in pixels
+   * @param cellSize grid spacing in pixels
+   * @param refinements number of Newton steps after interpolation
+   */
+  UndistortionGrid(const CALIBRATION& K, double width, double height,
+                   double cellSize = 8.0, size_t refinements = 1)
+      : K_(K), width_(width), height_(height), cellSize_(cellSize),
+        cols_(std::ceil(width / cellSize) + 1),
+        rows_(std::ceil(height / cellSize) + 1),
+        refinements_(refinements) {
+    batch::Point2s pixels;
+    pixels.reserve(cols_ * rows_);
+    for (size_t r = 0; r < rows_; r++)
+      for (size_t c = 0; c < cols_; c++)
+        pixels.push_back(Point2(c * cellSize_, r * cellSize_));
+    batch::calibrate(K_, pixels, &nodes_);
+  }
+
+  /// The calibration
+  const CALIBRATION& calibration() const { return K_; }
+
+  /// Whether the pixel is covered by the grid
+  bool contains(const Point2& pi) const {
+    return pi.x() >= 0 && pi.y() >= 0 && pi.x() <= width_ && pi.y() <= height_;
+  }
+
+  /// Same as calibration().calibrate(pi), but faster inside the image
+  Point2 calibrate(const Point2& pi) const {
+    if (!contains(pi)) return K_.calibrate(pi);
+
+    // Bilinear interpolation in the cell containing pi
+    const double x = pi.x() / cellSize_, y = pi.y() / cellSize_;
+    const size_t c = std::min<size_t>(x, cols_ - 2);
+    const size_t r = std::min<size_t>(y, rows_ - 2);
+    const double tx = x - c, ty = y - r;
+    const Point2* node = &nodes_[r * cols_ + c];
+    Vector2 pn = (1 - ty) * ((1 - tx) * node[0] + tx * node[1]) +
+                 ty * ((1 - tx) * node[cols_] + tx * node[cols_ + 1]);
+
+    // Newton steps on uncalibrate(pn) = pi
+    for (size_t i = 0; i < refinements_; i++) {
+      Matrix2 H;
+      const Vector2 error = pi - K_.uncalibrate(Point2(pn), boost::none, H);
+      pn += H.inverse() * error;
+    }
+    return Point2(pn);
+  }
+
+  /// Batched calibrate, pn[i] = calibrate(pi[i])
+  void calibrate(const batch::Point2s& pi, batch::Point2s* pn) const {
+    pn->resize(pi.size());
+    for (size_t i = 0; i < pi.size(); i++) (*pn)[i] = calibrate(pi[i]);
+  }
+};
+
+} // namespace gtsam
@@ -21,7 +21,6 @@
 
 #include <gtsam/geometry/Unit3.h>
 #include <gtsam/geometry/Point2.h>
-#include <gtsam/config.h>  // for GTSAM_USE_TBB
 
 #ifdef __clang__
 #  pragma clang diagnostic push
@@ -80,62 +79,68 @@ static Point3 CalculateBestAxis(const Point3& n) {
 
 /* ************************************************************************* */
 const Matrix32& Unit3::basis(OptionalJacobian<6, 2> H) const {
-#ifdef GTSAM_USE_TBB
-  // NOTE(hayk): At some point it seemed like this reproducably resulted in
-  // deadlock. However, I don't know why and I can no longer reproduce it.
-  // It either was a red herring or there is still a latent bug left to debug.
-  tbb::mutex::scoped_lock lock(B_mutex_);
-#endif
-
-  const bool cachedBasis = static_cast<bool>(B_);
-  const bool cachedJacobian = static_cast<bool>(H_B_);
-
-  if (H) {
-    if (!cachedJacobian) {
-      // Compute Jacobian. Recomputes B_
-      Matrix32 B;
-      Matrix62 jacobian;
-      Matrix33 H_B1_n, H_b1_B1, H_b2_n, H_b2_b1;
-
-      // Choose the direction of the first basis vector b1 in the tangent plane
-      // by crossing n with the chosen axis.
-      const Point3 n(p_), axis = CalculateBestAxis(n);
-      const Point3 B1 = gtsam::cross(n, axis, &H_B1_n);
-
-      // Normalize result to get a unit vector: b1 = B1 / |B1|.
-      B.col(0) = normalize(B1, &H_b1_B1);
-
-      // Get the second basis vector b2, which is orthogonal to n and b1.
-      B.col(1) = gtsam::cross(n, B.col(0), &H_b2_n, &H_b2_b1);
-
-      // Chain rule tomfoolery to compute the jacobian.
-      const Matrix32& H_n_p = B;
-      jacobian.block<3, 2>(0, 0) = H_b1_B1 * H_B1_n * H_n_p;
-      auto H_b1_p = jacobian.block<3, 2>(0, 0);
-      jacobian.block<3, 2>(3, 0) = H_b2_n * H_n_p + H_b2_b1 * H_b1_p;
-
-      // Cache the result and jacobian
-      H_B_.reset(jacobian);
-      B_.reset(B);
-    }
+  // Fast path: a single acquire load once the cache is filled
+  const unsigned char needed = H ? (kBasisCached | kJacobianCached) : kBasisCached;
+  if ((cache_.load(std::memory_order_acquire) & needed) != needed)
+    computeBasis(static_cast<bool>(H));
 
-    // Return cached jacobian, possibly computed just above
-    *H = *H_B_;
-  }
+  if (H)
+    *H = H_B_;
+  return B_;
+}
 
-  if (!cachedBasis) {
+/* ************************************************************************* */
+void Unit3::computeBasis(bool withJacobian) const {
+  Matrix32 B;
+  Matrix62 jacobian;
+
+  // Choose the direction of the first basis vector b1 in the tangent plane
+  // by crossing n with the chosen axis.
+  const Point3 n(p_), axis = CalculateBestAxis(n);
+  if (withJacobian) {
+    Matrix33 H_B1_n, H_b1_B1, H_b2_n, H_b2_b1;
+    const Point3 B1 = gtsam::cross(n, axis, &H_B1_n);
+
+    // Normalize result to get a unit vector: b1 = B1 / |B1|.
+    B.col(0) = normalize(B1, &H_b1_B1);
+
+    // Get the second basis vector b2, which is orthogonal to n and b1.
+    B.col(1) = gtsam::cross(n, B.col(0), &H_b2_n, &H_b2_b1);
+
+    // Chain rule tomfoolery to compute the jacobian.
+    const Matrix32& H_n_p = B;
+    jacobian.block<3, 2>(0, 0) = H_b1_B1 * H_B1_n * H_n_p;
+    auto H_b1_p = jacobian.block<3, 2>(0, 0);
+    jacobian.block<3, 2>(3, 0) = H_b2_n * H_n_p + H_b2_b1 * H_b1_p;
+  } else {
     // Same calculation as above, without derivatives.
-    // Done after H block, as that possibly computes B_ for the first time
-    Matrix32 B;
-
-    const Point3 n(p_), axis = CalculateBestAxis(n);
     const Point3 B1 = gtsam::cross(n, axis);
     B.col(0) = normalize(B1);
     B.col(1) = gtsam::cross(n, B.col(0));
-    B_.reset(B);
   }
 
-  return *B_;
+  // Claim the right to write the cache. Another thread can only hold it for the
+  // few stores below, so spinning is cheaper than blocking. If it published
+  // what we need in the meantime, we are done.
+  const unsigned char needed =
+      withJacobian ? (kBasisCached | kJacobianCached) : kBasisCached;
+  unsigned char state = cache_.load(std::memory_order_acquire);
+  while (true) {
+    if ((state & needed) == needed)
+      return;
+    if (state & kWriting)
+      state = cache_.load(std::memory_order_acquire);
+    else if (cache_.compare_exchange_weak(state, state | kWriting,
+        std::memory_order_acquire))
+      break;
+  }
+
+  // Readers may be reading an already cached basis, so never overwrite it
+  if (!(state & kBasisCached))
+    B_ = B;
+  if (withJacobian)
+    H_B_ = jacobian;
+  cache_.store(state | needed, std::memory_order_release);
 }
 
 /* ************************************************************************* */
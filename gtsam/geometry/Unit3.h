@@ -30,12 +30,9 @@
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/serialization/nvp.hpp>
 
+#include <atomic>
 #include <string>
 
-#ifdef GTSAM_USE_TBB
-#include <tbb/mutex.h>
-#endif
-
 namespace gtsam {
 
 /// Represents a 3D point on a unit sphere.
@@ -44,12 +41,21 @@ class Unit3 {
 private:
 
   Vector3 p_; ///< The location of the point on the unit sphere
-  mutable boost::optional<Matrix32> B_; ///< Cached basis
-  mutable boost::optional<Matrix62> H_B_; ///< Cached basis derivative
+  mutable Matrix32 B_; ///< Cached basis, valid if kBasisCached is set
+  mutable Matrix62 H_B_; ///< Cached basis derivative, valid if kJacobianCached is set
+
+  /// Flags in cache_
+  enum : unsigned char {
+    kBasisCached = 1, kJacobianCached = 2, kWriting = 4
+  };
 
-#ifdef GTSAM_USE_TBB
-  mutable tbb::mutex B_mutex_; ///< Mutex to protect the cached basis.
-#endif
+  /**
+   * State of the cache. Readers only do an acquire load, so basis() takes no
+   * lock once the cache is filled. The basis is computed outside of any
+   * critical section, and the kWriting flag only serializes the few stores
+   * that publish it, in case several threads race to fill the same cache.
+   */
+  mutable std::atomic<unsigned char> cache_;
 
 public:
 
@@ -62,34 +68,38 @@ public:
 
   /// Default constructor
   Unit3() :
-      p_(1.0, 0.0, 0.0) {
+      p_(1.0, 0.0, 0.0), cache_(0) {
   }
 
   /// Construct from point
   explicit Unit3(const Vector3& p) :
-      p_(p.normalized()) {
+      p_(p.normalized()), cache_(0) {
   }
 
   /// Construct from x,y,z
   Unit3(double x, double y, double z) :
-      p_(x, y, z) {
+      p_(x, y, z), cache_(0) {
     p_.normalize();
   }
 
   /// Construct from 2D point in plane at focal length f
   /// Unit3(p,1) can be viewed as normalized homogeneous coordinates of 2D point
-  explicit Unit3(const Point2& p, double f) : p_(p.x(), p.y(), f) {
+  explicit Unit3(const Point2& p, double f) : p_(p.x(), p.y(), f), cache_(0) {
     p_.normalize();
   }
 
-  /// Copy constructor
-  Unit3(const Unit3& u) {
-    p_ = u.p_;
+  /// Copy constructor, also copies the cached basis if there is one
+  Unit3(const Unit3& u) : p_(u.p_), cache_(0) {
+    copyCache(u);
   }
 
-  /// Copy assignment
+  /// Copy assignment, also copies the cached basis if there is one
   Unit3& operator=(const Unit3 & u) {
-    p_ = u.p_;
+    if (this != &u) {
+      p_ = u.p_;
+      cache_.store(0, std::memory_order_relaxed);
+      copyCache(u);
+    }
     return *this;
   }
 
@@ -127,6 +137,18 @@ public:
    */
   GTSAM_EXPORT const Matrix32& basis(OptionalJacobian<6, 2> H = boost::none) const;
 
+  /**
+   * Fill the basis cache of a range of Unit3, e.g., before linearizing a graph
+   * in parallel, so that all threads find the bases already computed.
+   * @param withJacobians also cache the basis derivatives
+   */
+  template <class ITERATOR>
+  static void CacheBases(ITERATOR first, ITERATOR last, bool withJacobians = false) {
+    Matrix62 H;
+    for (; first != last; ++first)
+      first->basis(withJacobians ? &H : nullptr);
+  }
+
   /// Return skew-symmetric associated with 3D point on unit sphere
   GTSAM_EXPORT Matrix3 skew() const;
 
@@ -197,6 +219,18 @@ public:
 
 private:
 
+  /// Compute the basis, and derivatives if asked, and publish them in the cache
+  GTSAM_EXPORT void computeBasis(bool withJacobian) const;
+
+  /// Copy the cache of u, which has the same p_, if it is filled
+  void copyCache(const Unit3& u) {
+    const unsigned char state =
+        u.cache_.load(std::memory_order_acquire) & (kBasisCached | kJacobianCached);
+    if (state & kBasisCached) B_ = u.B_;
+    if (state & kJacobianCached) H_B_ = u.H_B_;
+    cache_.store(state, std::memory_order_release);
+  }
+
   /// @name Advanced Interface
   /// @{
   /** Serialization function */
@@ -204,6 +238,8 @@ private:
   template<class ARCHIVE>
   void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
     ar & BOOST_SERIALIZATION_NVP(p_);
+    if (ARCHIVE::is_loading::value)
+      cache_.store(0, std::memory_order_relaxed);
   }
 
   /// @}
@@ -0,0 +1,205 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   testBatchCamera.cpp
+ * @brief  Unit tests for batched camera projection and calibration
+ */
+
+#include <gtsam/geometry/BatchCamera.h>
+#include <gtsam/geometry/Cal3DS2.h>
+#include <gtsam/geometry/UndistortionGrid.h>
+#include <gtsam/base/Testable.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Seven points, so the last block is only partially used, one behind the camera.
+namespace {
+const Pose3 kPose(Rot3::RzRyRx(-M_PI_2 + 0.1, 0.05, -M_PI_2 - 0.2), Point3(0.1, -0.2, 1.0));
+const Cal3_S2 kCal3_S2(500, 480, 0.1, 320, 240);
+const Cal3DS2 kCal3DS2(500, 480, 0.1, 320, 240, -0.2, 0.05, 1e-3, -2e-3);
+const Cal3Unified kCal3Unified(500, 480, 0.1, 320, 240, -0.2, 0.05, 1e-3, -2e-3, 0.3);
+
+batch::Point3s points() {
+  batch::Point3s result;
+  result.push_back(Point3(5, 0.1, 1.2));
+  result.push_back(Point3(4, -1.0, 0.5));
+  result.push_back(Point3(6, 1.5, 2.0));
+  result.push_back(Point3(3, 0.3, 0.2));
+  result.push_back(Point3(8, -2.0, 1.0));
+  result.push_back(Point3(-3, 0.5, 1.0));
+  result.push_back(Point3(4.5, 0.8, 0.7));
+  return result;
+}
+
+batch::Point2s intrinsics() {
+  batch::Point2s result;
+  for (double x = -0.4; x <= 0.4; x += 0.2)
+    result.push_back(Point2(x, -0.5 * x + 0.1));
+  result.push_back(Point2(0, 0));
+  return result;
+}
+
+// Compare batched uncalibrate and calibrate against the single-point versions
+template <class CALIBRATION, int DimK>
+bool checkUncalibrate(const CALIBRATION& K) {
+  const batch::Point2s pn = intrinsics();
+  batch::Point2s pi;
+  batch::Matrix2Ds<DimK> Dcal;
+  batch::Matrix2s Dp;
+  batch::uncalibrate(K, pn, &pi, &Dcal, &Dp);
+  bool ok = pi.size() == pn.size();
+  for (size_t i = 0; i < pn.size(); i++) {
+    Eigen::Matrix<double, 2, DimK> expectedDcal;
+    Matrix2 expectedDp;
+    ok &= assert_equal(K.uncalibrate(pn[i], expectedDcal, expectedDp), pi[i], 1e-9);
+    ok &= assert_equal(expectedDcal, Dcal[i], 1e-9);
+    ok &= assert_equal(expectedDp, Dp[i], 1e-9);
+  }
+
+  // And back
+  batch::Point2s actual;
+  batch::calibrate(K, pi, &actual);
+  for (size_t i = 0; i < pn.size(); i++)
+    ok &= assert_equal(K.calibrate(pi[i]), actual[i], 1e-9);
+  return ok;
+}
+}
+
+/* ************************************************************************* */
+TEST(BatchCamera, projectPose) {
+  const batch::Point3s pw = points();
+  batch::Point2s pn;
+  batch::Matrix26s Dpose;
+  batch::Matrix23s Dpoint;
+  vector<bool> inFront;
+  batch::project(kPose, pw, &pn, &Dpose, &Dpoint, &inFront);
+
+  const PinholeBase camera(kPose);
+  for (size_t i = 0; i < pw.size(); i++) {
+    pair<Point2, bool> expected = camera.projectSafe(pw[i]);
+    EXPECT(assert_equal(expected.first, pn[i], 1e-9));
+    EXPECT(expected.second == inFront[i]);
+    if (!expected.second) continue;
+    Matrix26 expectedDpose;
+    Matrix23 expectedDpoint;
+    camera.project2(pw[i], expectedDpose, expectedDpoint);
+    EXPECT(assert_equal(expectedDpose, Dpose[i], 1e-9));
+    EXPECT(assert_equal(expectedDpoint, Dpoint[i], 1e-9));
+  }
+  EXPECT(!inFront[5]);
+}
+
+/* ************************************************************************* */
+TEST(BatchCamera, Cal3_S2) { EXPECT((checkUncalibrate<Cal3_S2, 5>(kCal3_S2))); }
+TEST(BatchCamera, Cal3DS2) { EXPECT((checkUncalibrate<Cal3DS2, 9>(kCal3DS2))); }
+TEST(BatchCamera, Cal3Unified) { EXPECT((checkUncalibrate<Cal3Unified, 10>(kCal3Unified))); }
+
+/* ************************************************************************* */
+TEST(BatchCamera, calibrateFails) {
+  // A pixel far outside the image, where the fixed point iteration diverges
+  batch::Point2s pi(5, Point2(320, 240));
+  pi[3] = Point2(1e4, -1e4);
+  batch::Point2s pn;
+  CHECK_EXCEPTION(batch::calibrate(kCal3DS2, pi, &pn), std::runtime_error);
+}
+
+/* ************************************************************************* */
+TEST(BatchCamera, projectPinholeCamera) {
+  typedef PinholeCamera<Cal3DS2> Camera;
+  const Camera camera(kPose, kCal3DS2);
+  batch::Point3s pw = points();
+  pw.erase(pw.begin() + 5);  // the point behind the camera
+
+  batch::Point2s pi;
+  batch::Matrix2Ds<15> Dcamera;
+  batch::Matrix23s Dpoint;
+  batch::project(camera, pw, &pi, &Dcamera, &Dpoint);
+  for (size_t i = 0; i < pw.size(); i++) {
+    Eigen::Matrix<double, 2, 15> expectedDcamera;
+    Matrix23 expectedDpoint;
+    EXPECT(assert_equal(camera.project2(pw[i], expectedDcamera, expectedDpoint), pi[i], 1e-9));
+    EXPECT(assert_equal(expectedDcamera, Dcamera[i], 1e-9));
+    EXPECT(assert_equal(expectedDpoint, Dpoint[i], 1e-9));
+  }
+
+  // Backproject at the original depths
+  vector<double> depths;
+  for (const Point3& p : pw)
+    depths.push_back(kPose.transformTo(p).z());
+  batch::Point3s actual;
+  batch::backproject(camera, pi, depths, &actual);
+  for (size_t i = 0; i < pw.size(); i++)
+    EXPECT(assert_equal(pw[i], actual[i], 1e-6));
+}
+
+/* ************************************************************************* */
+TEST(BatchCamera, projectCameraSet) {
+  CameraSet<PinholeCamera<Cal3_S2> > cameras;
+  cameras.push_back(PinholeCamera<Cal3_S2>(kPose, kCal3_S2));
+  cameras.push_back(PinholeCamera<Cal3_S2>(kPose.compose(Pose3(Rot3(), Point3(0.5, 0, 0))), kCal3_S2));
+
+  const batch::Point3s pw = points();
+  vector<batch::Point2s> z;
+  vector<vector<bool> > inFront;
+  batch::project(cameras, pw, &z, &inFront);
+  LONGS_EQUAL(2, z.size());
+  for (size_t j = 0; j < cameras.size(); j++)
+    for (size_t i = 0; i < pw.size(); i++) {
+      const pair<Point2, bool> expected = cameras[j].projectSafe(pw[i]);
+      EXPECT(expected.second == inFront[j][i]);
+      if (expected.second)
+        EXPECT(assert_equal(cameras[j].project2(pw[i]), z[j][i], 1e-9));
+    }
+}
+
+/* ************************************************************************* */
+// Milder distortion, so calibrate converges all the way into the image corners
+namespace {
+const Cal3DS2 kMildCal3DS2(500, 480, 0.1, 320, 240, -0.05, 0.01, 1e-3, -2e-3);
+const Cal3Unified kMildCal3Unified(500, 480, 0.1, 320, 240, -0.05, 0.01, 1e-3, -2e-3, 0.1);
+}
+
+/* ************************************************************************* */
+TEST(UndistortionGrid, Cal3DS2) {
+  const UndistortionGrid<Cal3DS2> grid(kMildCal3DS2, 640, 480, 16);
+  batch::Point2s pi;
+  for (double u = 0; u <= 640; u += 37.3)
+    for (double v = 0; v <= 480; v += 41.9)
+      pi.push_back(Point2(u, v));
+  pi.push_back(Point2(640, 480));
+  pi.push_back(Point2(-10, 20));  // outside, falls back to calibrate
+
+  batch::Point2s actual;
+  grid.calibrate(pi, &actual);
+  for (size_t i = 0; i < pi.size(); i++)
+    EXPECT(assert_equal(kMildCal3DS2.calibrate(pi[i], 1e-8), actual[i], 1e-7));
+}
+
+/* ************************************************************************* */
+TEST(UndistortionGrid, Cal3Unified) {
+  const UndistortionGrid<Cal3Unified> grid(kMildCal3Unified, 640, 480, 16);
+  for (double u = 3; u <= 640; u += 91.7)
+    for (double v = 5; v <= 480; v += 77.1) {
+      const Point2 pi(u, v);
+      EXPECT(assert_equal(kMildCal3Unified.calibrate(pi, 1e-8), grid.calibrate(pi), 1e-7));
+    }
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,121 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   testBatchPose3.cpp
+ * @brief  Unit tests for batched Rot3/Pose3 operations
+ */
+
+#include <gtsam/geometry/BatchPose3.h>
+#include <gtsam/base/Testable.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Six elements, so the last block is only partially used, including a
+// tangent vector near zero to exercise the per-lane branch
+namespace {
+batch::Vector6s xis() {
+  batch::Vector6s result;
+  result.push_back((Vector6() << 0.1, 0.2, 0.3, 1, 2, 3).finished());
+  result.push_back((Vector6() << -0.5, 0.4, 1.2, 0, -1, 2).finished());
+  result.push_back((Vector6() << 1e-10, 0, -1e-10, 0.1, 0, 0).finished());
+  result.push_back((Vector6() << 2.0, -1.0, 0.5, 4, 5, 6).finished());
+  result.push_back((Vector6() << 0, 0, 3.0, -2, 0, 1).finished());
+  result.push_back((Vector6() << 0.3, -0.3, 0.3, 0, 0, 0).finished());
+  return result;
+}
+
+batch::Pose3s poses(double scale) {
+  batch::Pose3s result;
+  for (const Vector6& xi : xis())
+    result.push_back(Pose3::Expmap(scale * xi));
+  return result;
+}
+}
+
+/* ************************************************************************* */
+TEST(BatchPose3, Expmap) {
+  batch::Vector3s omegas;
+  for (const Vector6& xi : xis())
+    omegas.push_back(xi.head<3>());
+
+  batch::Rot3s actual;
+  batch::Matrix3s H;
+  batch::Expmap(omegas, &actual, &H);
+  LONGS_EQUAL(omegas.size(), actual.size());
+  for (size_t i = 0; i < omegas.size(); i++) {
+    Matrix3 expectedH;
+    const Rot3 expected = Rot3::Expmap(omegas[i], expectedH);
+    EXPECT(assert_equal(expected, actual[i], 1e-9));
+    EXPECT(assert_equal(expectedH, H[i], 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(BatchPose3, compose) {
+  const batch::Pose3s a = poses(1.0), b = poses(-0.7);
+  batch::Pose3s actual;
+  batch::Matrix6s Ha, Hb;
+  batch::compose(a, b, &actual, &Ha, &Hb);
+  for (size_t i = 0; i < a.size(); i++) {
+    Matrix6 expectedHa, expectedHb;
+    const Pose3 expected = a[i].compose(b[i], expectedHa, expectedHb);
+    EXPECT(assert_equal(expected, actual[i], 1e-9));
+    EXPECT(assert_equal(expectedHa, Ha[i], 1e-9));
+    EXPECT(assert_equal(expectedHb, Hb[i], 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(BatchPose3, between) {
+  const batch::Pose3s a = poses(1.0), b = poses(0.4);
+  batch::Pose3s actual;
+  batch::Matrix6s Ha, Hb;
+  batch::between(a, b, &actual, &Ha, &Hb);
+  for (size_t i = 0; i < a.size(); i++) {
+    Matrix6 expectedHa, expectedHb;
+    const Pose3 expected = a[i].between(b[i], expectedHa, expectedHb);
+    EXPECT(assert_equal(expected, actual[i], 1e-9));
+    EXPECT(assert_equal(expectedHa, Ha[i], 1e-9));
+    EXPECT(assert_equal(expectedHb, Hb[i], 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(BatchPose3, retractAndLocal) {
+  const batch::Pose3s a = poses(1.0);
+  const batch::Vector6s deltas = xis();
+  batch::Pose3s retracted;
+  batch::retract(a, deltas, &retracted);
+  batch::Vector6s local;
+  batch::localCoordinates(a, retracted, &local);
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT(assert_equal(a[i].retract(deltas[i]), retracted[i], 1e-9));
+    EXPECT(assert_equal(a[i].localCoordinates(retracted[i]), local[i], 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(BatchPose3, sizeMismatch) {
+  batch::Pose3s actual;
+  CHECK_EXCEPTION(batch::compose(poses(1.0), batch::Pose3s(2), &actual),
+                  std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -335,6 +335,32 @@ TEST(Unit3, basis) {
   EXPECT(assert_equal(expectedH, actualH, 1e-8));
 }
 
+//*******************************************************************************
+TEST(Unit3, basis_cache) {
+  const Unit3 p(0.1, -0.2, 0.9);
+  Matrix62 expectedH;
+  const Matrix32 expected = Unit3(p).basis(expectedH);
+
+  // Jacobian asked for after the basis alone has been cached
+  Matrix62 actualH;
+  EXPECT(assert_equal(expected, p.basis(), 1e-9));
+  EXPECT(assert_equal(expected, p.basis(actualH), 1e-9));
+  EXPECT(assert_equal(expectedH, actualH, 1e-9));
+
+  // Copies keep the cached basis, assignment replaces it
+  Unit3 q(p);
+  EXPECT(assert_equal(expected, q.basis(actualH), 1e-9));
+  EXPECT(assert_equal(expectedH, actualH, 1e-9));
+  q = Unit3(1, 0, 0);
+  EXPECT(assert_equal(Unit3(1, 0, 0).basis(), q.basis(), 1e-9));
+
+  // Filling the caches of a range
+  vector<Unit3> units(3, Unit3(0.3, 0.4, -0.5));
+  Unit3::CacheBases(units.begin(), units.end(), true);
+  for (const Unit3& u : units)
+    EXPECT(assert_equal(Unit3(0.3, 0.4, -0.5).basis(), u.basis(), 1e-9));
+}
+
 //*******************************************************************************
 /// Check the basis derivatives of a bunch of random Unit3s.
 TEST(Unit3, basis_derivatives) {
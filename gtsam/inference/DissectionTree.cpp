@@ -0,0 +1,202 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DissectionTree.cpp
+ * @brief   Separator tree of a nested dissection, computed in parallel
+ */
+
+#include <gtsam/inference/DissectionTree.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#include <boost/make_shared.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+#include <gtsam/3rdparty/metis/include/metis.h>
+#endif
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/parallel_invoke.h>
+#endif
+
+using namespace std;
+
+namespace gtsam {
+
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+namespace {
+
+/* ************************************************************************* */
+// A subgraph in METIS' CSR format, with the MetisIndex number of each vertex
+struct Subgraph {
+  vector<idx_t> xadj, adj;
+  vector<idx_t> vertices;
+};
+
+// Subgraphs smaller than this are dissected in the calling thread
+const size_t kParallelThreshold = 4096;
+
+DissectionTree::sharedNode Dissect(const MetisIndex& met, Subgraph& graph,
+                                   size_t leafSize);
+
+/* ************************************************************************* */
+// Dissects one half of a separated subgraph, see tbb::parallel_invoke
+struct DissectHalf {
+  const MetisIndex& met;
+  Subgraph& graph;
+  size_t leafSize;
+  DissectionTree::sharedNode& result;
+
+  DissectHalf(const MetisIndex& met, Subgraph& graph, size_t leafSize,
+              DissectionTree::sharedNode& result)
+      : met(met), graph(graph), leafSize(leafSize), result(result) {}
+
+  void operator()() const { result = Dissect(met, graph, leafSize); }
+};
+
+/* ************************************************************************* */
+// Order a leaf as a whole with METIS
+DissectionTree::sharedNode Leaf(const MetisIndex& met, Subgraph& graph) {
+  auto node = boost::make_shared<DissectionTree::Node>();
+  idx_t n = graph.vertices.size();
+  node->keys.reserve(n);
+  if (graph.adj.empty()) {  // no edges, so no fill
+    for (idx_t vertex : graph.vertices) node->keys.push_back(met.intToKey(vertex));
+    return node;
+  }
+  vector<idx_t> perm(n), iperm(n);
+  if (METIS_NodeND(&n, &graph.xadj[0], &graph.adj[0], NULL, NULL, &perm[0],
+                   &iperm[0]) != METIS_OK)
+    throw runtime_error("DissectionTree: METIS failed to order a subgraph");
+  for (idx_t j = 0; j < n; ++j)
+    node->keys.push_back(met.intToKey(graph.vertices[perm[j]]));
+  return node;
+}
+
+/* ************************************************************************* */
+DissectionTree::sharedNode Dissect(const MetisIndex& met, Subgraph& graph,
+                                   size_t leafSize) {
+  idx_t n = graph.vertices.size();
+  if (size_t(n) <= leafSize || graph.adj.empty()) return Leaf(met, graph);
+
+  // Split the vertices into two halves and a separator (part 2)
+  idx_t options[METIS_NOPTIONS];
+  METIS_SetDefaultOptions(options);
+  idx_t separatorSize;
+  vector<idx_t> part(n);
+  if (METIS_ComputeVertexSeparator(&n, &graph.xadj[0], &graph.adj[0], NULL,
+                                   options, &separatorSize, &part[0]) != METIS_OK)
+    throw runtime_error("DissectionTree: METIS failed to separate a subgraph");
+
+  // Number the vertices within their part
+  vector<idx_t> local(n);
+  idx_t sizes[3] = {0, 0, 0};
+  for (idx_t i = 0; i < n; ++i) local[i] = sizes[part[i]]++;
+  if (sizes[0] == 0 || sizes[1] == 0) return Leaf(met, graph);  // no progress
+
+  // Extract the two halves, dropping edges to the separator
+  Subgraph halves[2];
+  for (int p = 0; p < 2; ++p) {
+    halves[p].xadj.reserve(sizes[p] + 1);
+    halves[p].xadj.push_back(0);
+    halves[p].vertices.reserve(sizes[p]);
+  }
+  auto node = boost::make_shared<DissectionTree::Node>();
+  node->keys.reserve(sizes[2]);
+  for (idx_t i = 0; i < n; ++i) {
+    const idx_t p = part[i];
+    if (p == 2) {
+      node->keys.push_back(met.intToKey(graph.vertices[i]));
+      continue;
+    }
+    Subgraph& half = halves[p];
+    for (idx_t e = graph.xadj[i]; e < graph.xadj[i + 1]; ++e)
+      if (part[graph.adj[e]] == p) half.adj.push_back(local[graph.adj[e]]);
+    half.xadj.push_back(half.adj.size());
+    half.vertices.push_back(graph.vertices[i]);
+  }
+  // Free the memory of this level before recursing
+  vector<idx_t>().swap(graph.xadj);
+  vector<idx_t>().swap(graph.adj);
+
+  node->children.resize(2);
+  const DissectHalf first(met, halves[0], leafSize, node->children[0]),
+      second(met, halves[1], leafSize, node->children[1]);
+#ifdef GTSAM_USE_TBB
+  if (size_t(n) >= kParallelThreshold) {
+    tbb::parallel_invoke(first, second);
+    return node;
+  }
+#endif
+  first();
+  second();
+  return node;
+}
+
+}  // namespace
+#endif
+
+/* ************************************************************************* */
+DissectionTree::DissectionTree(const MetisIndex& met, size_t leafSize) {
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+  gttic(DissectionTree);
+  Subgraph graph;
+  graph.xadj.assign(met.xadj().begin(), met.xadj().end());
+  graph.adj.assign(met.adj().begin(), met.adj().end());
+  graph.vertices.resize(met.nValues());
+  for (size_t j = 0; j < met.nValues(); ++j) graph.vertices[j] = j;
+  root_ = Dissect(met, graph, max(leafSize, size_t(1)));
+#else
+  throw runtime_error("GTSAM was built without support for Metis-based "
+                      "nested dissection");
+#endif
+}
+
+/* ************************************************************************* */
+Ordering DissectionTree::ordering() const {
+  Ordering result;
+  // Iterative postorder, children in order
+  vector<pair<const Node*, size_t> > stack(1, make_pair(root_.get(), size_t(0)));
+  while (!stack.empty()) {
+    pair<const Node*, size_t>& top = stack.back();
+    if (top.second < top.first->children.size()) {
+      const Node* child = top.first->children[top.second++].get();
+      stack.push_back(make_pair(child, size_t(0)));
+    } else {
+      result.insert(result.end(), top.first->keys.begin(), top.first->keys.end());
+      stack.pop_back();
+    }
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+void DissectionTree::print(const string& s,
+                           const KeyFormatter& keyFormatter) const {
+  cout << s << endl;
+  vector<pair<const Node*, string> > stack(1, make_pair(root_.get(), string("")));
+  while (!stack.empty()) {
+    const Node* node = stack.back().first;
+    const string indent = stack.back().second;
+    stack.pop_back();
+    cout << indent << "- ";
+    for (Key key : node->keys) cout << keyFormatter(key) << " ";
+    cout << endl;
+    for (size_t i = node->children.size(); i-- > 0;)
+      stack.push_back(make_pair(node->children[i].get(), indent + "| "));
+  }
+}
+
+}  // namespace gtsam
@@ -0,0 +1,82 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    DissectionTree.h
+ * @brief   Separator tree of a nested dissection, computed in parallel
+ */
+
+#pragma once
+
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/MetisIndex.h>
+#include <gtsam/base/FastVector.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace gtsam {
+
+/**
+ * The separator tree of a nested dissection of a factor graph.  Every node
+ * holds the vertex separator that splits its subgraph in two, and has the
+ * dissections of the two halves as children; leaves hold small subgraphs,
+ * ordered with METIS as a whole.  The halves are dissected concurrently when
+ * GTSAM is built with TBB.
+ *
+ * Eliminating in the order returned by ordering(), i.e. children before their
+ * parents, gives a Bayes tree in which the subtrees of the two halves of every
+ * separator are disjoint, so the junction tree, and hence parallel
+ * elimination, follow the dissection.
+ */
+class GTSAM_EXPORT DissectionTree {
+ public:
+  struct Node {
+    KeyVector keys;  ///< The separator, or all variables of a leaf
+    FastVector<boost::shared_ptr<Node> > children;
+  };
+  typedef boost::shared_ptr<Node> sharedNode;
+
+ private:
+  sharedNode root_;
+
+ public:
+  /// @name Standard Constructors
+  /// @{
+
+  /**
+   * Dissect the graph of a MetisIndex, until subgraphs have at most
+   * \c leafSize variables.
+   */
+  explicit DissectionTree(const MetisIndex& met, size_t leafSize = 128);
+
+  /// Dissect the variables of a factor graph
+  template <class FACTOR_GRAPH>
+  explicit DissectionTree(const FACTOR_GRAPH& graph, size_t leafSize = 128)
+      : DissectionTree(MetisIndex(graph), leafSize) {}
+
+  /// @}
+  /// @name Standard Interface
+  /// @{
+
+  /// The root of the tree, whose separator splits the whole graph
+  const sharedNode& root() const { return root_; }
+
+  /// The elimination ordering: every node after its children
+  Ordering ordering() const;
+
+  /// Print the tree
+  void print(const std::string& s = "DissectionTree",
+             const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+  /// @}
+};
+
+}  // namespace gtsam
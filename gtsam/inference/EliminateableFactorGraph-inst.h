@@ -58,6 +58,9 @@ namespace gtsam {
       if (orderingType == Ordering::METIS) {
         Ordering computedOrdering = Ordering::Metis(asDerived());
         return eliminateSequential(computedOrdering, function, variableIndex, orderingType);
+      } else if (orderingType == Ordering::NESTED_DISSECTION) {
+        Ordering computedOrdering = Ordering::NestedDissection(asDerived());
+        return eliminateSequential(computedOrdering, function, variableIndex, orderingType);
       } else {
         Ordering computedOrdering = Ordering::Colamd(*variableIndex);
         return eliminateSequential(computedOrdering, function, variableIndex, orderingType);
@@ -100,6 +103,9 @@ namespace gtsam {
       if (orderingType == Ordering::METIS) {
         Ordering computedOrdering = Ordering::Metis(asDerived());
         return eliminateMultifrontal(computedOrdering, function, variableIndex, orderingType);
+      } else if (orderingType == Ordering::NESTED_DISSECTION) {
+        Ordering computedOrdering = Ordering::NestedDissection(asDerived());
+        return eliminateMultifrontal(computedOrdering, function, variableIndex, orderingType);
       } else {
         Ordering computedOrdering = Ordering::Colamd(*variableIndex);
         return eliminateMultifrontal(computedOrdering, function, variableIndex, orderingType);
@@ -90,6 +90,7 @@ namespace gtsam {
     // Allocate result parent vector and vector of last factor columns
     FastVector<sharedNode> nodes(n);
     FastVector<size_t> parents(n, none);
+    FastVector<size_t> ancestors(n, none);
     FastVector<size_t> prevCol(m, none);
     FastVector<bool> factorUsed(m, false);
 
@@ -98,7 +99,7 @@ namespace gtsam {
       for (size_t j = 0; j < n; j++)
       {
         // Retrieve the factors involving this variable and create the current node
-        const FactorIndices& factors = structure[order[j]];
+        const VariableIndex::Factors factors = structure[order[j]];
         const sharedNode node = boost::make_shared<Node>();
         node->key = order[j];
 
@@ -110,20 +111,19 @@ namespace gtsam {
           // variable in this factor a child of the current node.  This means that the variables
           // eliminated earlier in the factor depend on the later variables in the factor.  If we
           // haven't yet hit a variable in this factor, we add the factor to the current node.
-          // TODO: Store root shortcuts instead of parents.
           if (prevCol[i] != none) {
-            size_t k = prevCol[i];
-            // Find root r of the current tree that contains k. Use raw pointers in computing the
-            // parents to avoid changing the reference counts while traversing up the tree.
-            size_t r = k;
-            while (parents[r] != none)
-              r = parents[r];
-            // If the root of the subtree involving this node is actually the current node,
-            // TODO: what does this mean?  forest?
-            if (r != j) {
-              // Now that we found the root, hook up parent and child pointers in the nodes.
-              parents[r] = j;
-              node->children.push_back(nodes[r]);
+            // Find the root of the current tree that contains the previous variable with Liu's
+            // algorithm, pointing every node on the path at j as we go (path compression), so
+            // later searches through this tree stop early.  If we reach j, the subtree is already
+            // our child.
+            for (size_t k = prevCol[i], next; k != none && k != j; k = next) {
+              next = ancestors[k];
+              ancestors[k] = j;
+              if (next == none) {
+                // k is the root: hook up parent and child pointers in the nodes.
+                parents[k] = j;
+                node->children.push_back(nodes[k]);
+              }
             }
           } else {
             // Add the factor to the current node since we are at the first variable in this factor.
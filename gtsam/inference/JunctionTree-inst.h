@@ -22,8 +22,7 @@
 
 #include <gtsam/inference/JunctionTree.h>
 #include <gtsam/inference/ClusterTree-inst.h>
-#include <gtsam/symbolic/SymbolicConditional.h>
-#include <gtsam/symbolic/SymbolicFactor-inst.h>
+#include <gtsam/inference/SymbolicAnalysis.h>
 
 namespace gtsam {
 
@@ -33,16 +32,16 @@ struct ConstructorTraversalData {
   typedef typename JunctionTree<BAYESTREE, GRAPH>::sharedNode sharedNode;
 
   ConstructorTraversalData* const parentData;
+  const AmalgamationParams* amalgamation;
+  const FastMap<Key, size_t>* conditionalSizes; // from the symbolic analysis
   sharedNode myJTNode;
-  FastVector<SymbolicConditional::shared_ptr> childSymbolicConditionals;
-  FastVector<SymbolicFactor::shared_ptr> childSymbolicFactors;
-
-  // Small inner class to store symbolic factors
-  class SymbolicFactors: public FactorGraph<Factor> {
-  };
+  FastVector<size_t> childNrParents; // number of parents of each child's conditional
+  FastVector<size_t> childZeros; // explicit zeros in each child clique
 
   ConstructorTraversalData(ConstructorTraversalData* _parentData) :
-      parentData(_parentData) {
+      parentData(_parentData),
+      amalgamation(_parentData ? _parentData->amalgamation : 0),
+      conditionalSizes(_parentData ? _parentData->conditionalSizes : 0) {
   }
 
   // Pre-order visitor function
@@ -62,58 +61,56 @@ struct ConstructorTraversalData {
   static void ConstructorTraversalVisitorPostAlg2(
       const boost::shared_ptr<ETREE_NODE>& ETreeNode,
       const ConstructorTraversalData& myData) {
-    // In this post-order visitor, we combine the symbolic elimination results
-    // from the elimination tree children and symbolically eliminate the current
-    // elimination tree node.  We then check whether each of our elimination
+    // In this post-order visitor, we check whether each of our elimination
     // tree child nodes should be merged with us.  The check for this is that
     // our number of symbolic elimination parents is exactly 1 less than
     // our child's symbolic elimination parents - this condition indicates that
     // eliminating the current node did not introduce any parents beyond those
-    // already in the child->
-
-    // Do symbolic elimination for this node
-    SymbolicFactors symbolicFactors;
-    symbolicFactors.reserve(
-        ETreeNode->factors.size() + myData.childSymbolicFactors.size());
-    // Add ETree node factors
-    symbolicFactors += ETreeNode->factors;
-    // Add symbolic factors passed up from children
-    symbolicFactors += myData.childSymbolicFactors;
-
-    Ordering keyAsOrdering;
-    keyAsOrdering.push_back(ETreeNode->key);
-    SymbolicConditional::shared_ptr myConditional;
-    SymbolicFactor::shared_ptr mySeparatorFactor;
-    boost::tie(myConditional, mySeparatorFactor) = internal::EliminateSymbolic(
-        symbolicFactors, keyAsOrdering);
-
-    // Store symbolic elimination results in the parent
-    myData.parentData->childSymbolicConditionals.push_back(myConditional);
-    myData.parentData->childSymbolicFactors.push_back(mySeparatorFactor);
+    // already in the child.  The number of parents of each conditional comes
+    // from the symbolic analysis, so no symbolic elimination is needed here.
+    const size_t myConditionalSize = myData.conditionalSizes->at(ETreeNode->key);
+    const size_t myNrParents = myConditionalSize - 1;
+    myData.parentData->childNrParents.push_back(myNrParents);
 
     sharedNode node = myData.myJTNode;
-    const FastVector<SymbolicConditional::shared_ptr>& childConditionals =
-        myData.childSymbolicConditionals;
-    node->problemSize_ = (int) (myConditional->size() * symbolicFactors.size());
+    const FastVector<size_t>& childNrParentsOf = myData.childNrParents;
+    node->problemSize_ = (int) (myConditionalSize
+        * (ETreeNode->factors.size() + ETreeNode->children.size()));
 
     // Merge our children if they are in our clique - if our conditional has
     // exactly one fewer parent than our child's conditional.
-    const size_t myNrParents = myConditional->nrParents();
     const size_t nrChildren = node->nrChildren();
-    assert(childConditionals.size() == nrChildren);
+    assert(childNrParentsOf.size() == nrChildren);
 
     // decide which children to merge, as index into children
     std::vector<size_t> nrFrontals = node->nrFrontalsOfChildren();
     std::vector<bool> merge(nrChildren, false);
     size_t myNrFrontals = 1;
+    size_t myZeros = 0;
     for (size_t i = 0;i<nrChildren;i++){
-      // Check if we should merge the i^th child
-      if (myNrParents + myNrFrontals == childConditionals[i]->nrParents()) {
+      // Check if we should merge the i^th child.  The child's frontal rows
+      // become dense over all our variables, of which it only touches its own
+      // parents, so merging it adds this many explicit zeros (0 if exact).
+      const size_t childNrParents = childNrParentsOf[i];
+      assert(childNrParents <= myNrParents + myNrFrontals);
+      const size_t addedZeros = nrFrontals[i] * (myNrParents + myNrFrontals - childNrParents);
+      bool mergeChild = (addedZeros == 0);
+      if (!mergeChild && myData.amalgamation && myData.amalgamation->relaxed()) {
+        // Relaxed amalgamation: merge if the merged clique stays sparse enough
+        const size_t F = myNrFrontals + nrFrontals[i];
+        const size_t entries = F * (F + 1) / 2 + F * myNrParents;
+        const size_t zeros = myZeros + myData.childZeros[i] + addedZeros;
+        mergeChild = F <= myData.amalgamation->maxFrontals
+            && zeros <= myData.amalgamation->maxZeroFraction * entries;
+      }
+      if (mergeChild) {
         // Increment number of frontal variables
         myNrFrontals += nrFrontals[i];
+        myZeros += myData.childZeros[i] + addedZeros;
         merge[i] = true;
       }
     }
+    myData.parentData->childZeros.push_back(myZeros);
 
     // now really merge
     node->mergeChildren(merge);
@@ -124,20 +121,70 @@ struct ConstructorTraversalData {
 template<class BAYESTREE, class GRAPH>
 template<class ETREE_BAYESNET, class ETREE_GRAPH>
 JunctionTree<BAYESTREE, GRAPH>::JunctionTree(
-    const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree) {
+    const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree,
+    const AmalgamationParams& amalgamation) {
   gttic(JunctionTree_FromEliminationTree);
   // Here we rely on the BayesNet having been produced by this elimination tree,
   // such that the conditionals are arranged in DFS post-order.  We traverse the
-  // elimination tree, and inspect the symbolic conditional corresponding to
-  // each node.  The elimination tree node is added to the same clique with its
-  // parent if it has exactly one more Bayes net conditional parent than
-  // does its elimination tree parent.
-
-  // Traverse the elimination tree, doing symbolic elimination and merging nodes
-  // as we go.  Gather the created junction tree roots in a dummy Node.
+  // elimination tree, and inspect the size of the symbolic conditional
+  // corresponding to each node.  The elimination tree node is added to the same
+  // clique with its parent if it has exactly one more Bayes net conditional
+  // parent than does its elimination tree parent, or if relaxed amalgamation
+  // allows it.
   typedef typename EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>::Node ETreeNode;
+  typedef typename EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>::sharedNode ETreeSharedNode;
   typedef ConstructorTraversalData<BAYESTREE, GRAPH, ETreeNode> Data;
+
+  // Number the eliminated variables in a postorder of the elimination tree,
+  // which is an elimination order that yields the same conditionals, followed
+  // by the separator variables that are not eliminated.
+  gttic(SymbolicAnalysis);
+  FastVector<const ETreeNode*> postorder;
+  {
+    FastVector<std::pair<const ETreeNode*, size_t> > stack;
+    for (const ETreeSharedNode& root : eliminationTree.roots())
+      stack.push_back(std::make_pair(root.get(), size_t(0)));
+    while (!stack.empty()) {
+      std::pair<const ETreeNode*, size_t>& top = stack.back();
+      if (top.second < top.first->children.size()) {
+        const ETreeNode* child = top.first->children[top.second++].get();
+        stack.push_back(std::make_pair(child, size_t(0)));
+      } else {
+        postorder.push_back(top.first);
+        stack.pop_back();
+      }
+    }
+  }
+  FastMap<Key, size_t> positions;
+  for (size_t k = 0; k < postorder.size(); ++k)
+    positions.insert(std::make_pair(postorder[k]->key, k));
+  size_t nrVariables = postorder.size();
+  FastVector<size_t> factorStarts(1, 0), variables;
+  for (const ETreeNode* node : postorder) {
+    for (const auto& factor : node->factors) {
+      if (!factor) continue;
+      for (Key key : *factor) {
+        const auto position = positions.insert(std::make_pair(key, nrVariables));
+        if (position.second) ++nrVariables;
+        variables.push_back(position.first->second);
+      }
+      factorStarts.push_back(variables.size());
+    }
+  }
+
+  // Find the size of the conditional on each eliminated variable
+  const SymbolicAnalysis analysis(nrVariables, factorStarts, variables);
+  FastMap<Key, size_t> conditionalSizes;
+  for (size_t k = 0; k < postorder.size(); ++k)
+    conditionalSizes.insert(std::make_pair(
+        postorder[k]->key, analysis.columnCounts()[k]));
+  gttoc(SymbolicAnalysis);
+
+  // Traverse the elimination tree, merging nodes as we go.  Gather the created
+  // junction tree roots in a dummy Node.
   Data rootData(0);
+  rootData.amalgamation = &amalgamation;
+  rootData.conditionalSizes = &conditionalSizes;
   rootData.myJTNode = boost::make_shared<typename Base::Node>(); // Make a dummy node to gather
                                                                  // the junction tree roots
   treeTraversal::DepthFirstForest(eliminationTree, rootData,
@@ -27,6 +27,27 @@ namespace gtsam {
   // Forward declarations
   template<class BAYESNET, class GRAPH> class EliminationTree;
 
+  /**
+   * Controls how elimination tree nodes are merged into junction tree cliques.
+   * By default a child is only merged into its parent if that adds no explicit
+   * zeros, i.e., the cliques are fundamental supernodes. Relaxed amalgamation
+   * also merges a child if the fraction of explicit zeros in the merged clique
+   * stays at or below maxZeroFraction, trading some fill for larger dense
+   * blocks and fewer cliques. Zeros are counted per variable, not per scalar.
+   */
+  struct AmalgamationParams {
+    double maxZeroFraction; ///< Allowed fraction of explicit zeros in a clique, 0 for exact merging
+    size_t maxFrontals;     ///< Relaxed merges never grow a clique beyond this many frontal variables
+
+    explicit AmalgamationParams(double _maxZeroFraction = 0.0,
+        size_t _maxFrontals = 32) :
+        maxZeroFraction(_maxZeroFraction), maxFrontals(_maxFrontals) {
+    }
+
+    /// Whether any merges beyond the exact ones are allowed
+    bool relaxed() const { return maxZeroFraction > 0.0; }
+  };
+
   /**
    * A JunctionTree is a cluster tree, a set of variable clusters with factors, arranged in a tree,
    * with the additional property that it represents the clique tree associated with a Bayes Net.
@@ -62,11 +83,16 @@ namespace gtsam {
 
     /** Build the junction tree from an elimination tree. */
     template<class ETREE>
-      static This FromEliminationTree(const ETREE& eliminationTree) { return This(eliminationTree); }
+      static This FromEliminationTree(const ETREE& eliminationTree,
+          const AmalgamationParams& amalgamation = AmalgamationParams()) {
+        return This(eliminationTree, amalgamation);
+      }
 
-    /** Build the junction tree from an elimination tree. */
+    /** Build the junction tree from an elimination tree, merging nodes into cliques as
+     *  controlled by \c amalgamation. */
     template<class ETREE_BAYESNET, class ETREE_GRAPH>
-    JunctionTree(const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree);
+    JunctionTree(const EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>& eliminationTree,
+        const AmalgamationParams& amalgamation = AmalgamationParams());
 
     /// @}
 
@@ -16,12 +16,14 @@
  * @date    Sep 2, 2010
  */
 
+#include <algorithm>
 #include <vector>
 #include <limits>
 
 #include <boost/format.hpp>
 
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/DissectionTree.h>
 #include <gtsam/3rdparty/CCOLAMD/Include/ccolamd.h>
 
 #ifdef GTSAM_SUPPORT_NESTED_DISSECTION
@@ -77,12 +79,11 @@ Ordering Ordering::ColamdConstrained(const VariableIndex& variableIndex,
   int count = 0;
   KeyVector keys(nVars); // Array to store the keys in the order we add them so we can retrieve them in permuted order
   size_t index = 0;
-  for (auto key_factors: variableIndex) {
+  for (const VariableIndex::value_type key_factors: variableIndex) {
     // Arrange factor indices into COLAMD format
-    const FactorIndices& column = key_factors.second;
-    for(size_t factorIndex: column) {
-      A[count++] = (int) factorIndex; // copy sparse column
-    }
+    const VariableIndex::Factors& column = key_factors.second;
+    std::copy(column.begin(), column.end(), A.begin() + count); // copy sparse column
+    count += column.size();
     p[index + 1] = count;  // column j (base 1) goes from A[j-1] to A[j]-1
     // Store key in array and increment index
     keys[index] = key_factors.first;
@@ -137,7 +138,7 @@ Ordering Ordering::ColamdConstrainedLast(const VariableIndex& variableIndex,
   // TODO(frank): think of a way to not build this
   FastMap<Key, size_t> keyIndices;
   size_t j = 0;
-  for (auto key_factors: variableIndex)
+  for (const VariableIndex::value_type key_factors: variableIndex)
     keyIndices.insert(keyIndices.end(), make_pair(key_factors.first, j++));
 
   // If at least some variables are not constrained to be last, constrain the
@@ -164,7 +165,7 @@ Ordering Ordering::ColamdConstrainedFirst(const VariableIndex& variableIndex,
   // Build a mapping to look up sorted Key indices by Key
   FastMap<Key, size_t> keyIndices;
   size_t j = 0;
-  for (auto key_factors: variableIndex)
+  for (const VariableIndex::value_type key_factors: variableIndex)
     keyIndices.insert(keyIndices.end(), make_pair(key_factors.first, j++));
 
   // If at least some variables are not constrained to be last, constrain the
@@ -195,7 +196,7 @@ Ordering Ordering::ColamdConstrained(const VariableIndex& variableIndex,
   // Build a mapping to look up sorted Key indices by Key
   FastMap<Key, size_t> keyIndices;
   size_t j = 0;
-  for (auto key_factors: variableIndex)
+  for (const VariableIndex::value_type key_factors: variableIndex)
     keyIndices.insert(keyIndices.end(), make_pair(key_factors.first, j++));
 
   // Assign groups
@@ -246,6 +247,12 @@ Ordering Ordering::Metis(const MetisIndex& met) {
 #endif
 }
 
+/* ************************************************************************* */
+Ordering Ordering::NestedDissection(const MetisIndex& met) {
+  gttic(Ordering_NestedDissection);
+  return DissectionTree(met).ordering();
+}
+
 /* ************************************************************************* */
 void Ordering::print(const std::string& str,
     const KeyFormatter& keyFormatter) const {
@@ -39,7 +39,7 @@ public:
 
   /// Type of ordering to use
   enum OrderingType {
-    COLAMD, METIS, NATURAL, CUSTOM
+    COLAMD, METIS, NATURAL, CUSTOM, NESTED_DISSECTION
   };
 
   typedef Ordering This; ///< Typedef to this class
@@ -172,6 +172,56 @@ public:
   static GTSAM_EXPORT Ordering ColamdConstrained(
       const VariableIndex& variableIndex, const FastMap<Key, int>& groups);
 
+  /// Update an ordering \c previous, computed for an earlier version of a factor graph, to an
+  /// ordering of \c graph.  Variables that are no longer in the graph are dropped, the others keep
+  /// their relative order, and new variables are appended at the end, in a COLAMD ordering of
+  /// only the factors that involve them.  This is much cheaper than a fresh ordering when few
+  /// variables were added, but fill-in grows as the graph drifts away from the one \c previous
+  /// was computed for, so a fresh ordering should be computed every now and then.
+  template<class FACTOR_GRAPH>
+  static Ordering Incremental(const FACTOR_GRAPH& graph, const Ordering& previous) {
+    if (graph.empty())
+      return Ordering();
+    const VariableIndex variableIndex(graph);
+    KeyVector previousKeys(previous.begin(), previous.end());
+    std::sort(previousKeys.begin(), previousKeys.end());
+    const auto isPrevious = [&](Key key) {
+      return std::binary_search(previousKeys.begin(), previousKeys.end(), key);
+    };
+
+    Ordering ordering;
+    ordering.reserve(variableIndex.size());
+    for (Key key : previous)
+      if (variableIndex.find(key) != variableIndex.end())
+        ordering.push_back(key);
+
+    // Gather the factors involving new variables
+    FACTOR_GRAPH newFactors;
+    std::vector<bool> gathered(graph.size(), false);
+    for (const VariableIndex::value_type key_factors : variableIndex) {
+      if (isPrevious(key_factors.first))
+        continue;
+      for (const FactorIndex i : key_factors.second) {
+        if (!gathered[i]) {
+          gathered[i] = true;
+          newFactors.push_back(graph[i]);
+        }
+      }
+    }
+    if (newFactors.empty())
+      return ordering;
+
+    // Order the new variables with COLAMD, after the previous variables they are connected to
+    KeyVector connected;
+    for (Key key : newFactors.keys())
+      if (isPrevious(key))
+        connected.push_back(key);
+    for (Key key : ColamdConstrainedFirst(newFactors, connected))
+      if (!isPrevious(key))
+        ordering.push_back(key);
+    return ordering;
+  }
+
   /// Return a natural Ordering. Typically used by iterative solvers
   template<class FACTOR_GRAPH>
   static Ordering Natural(const FACTOR_GRAPH &fg) {
@@ -194,6 +244,15 @@ public:
     return Metis(MetisIndex(graph));
   }
 
+  /// Compute a nested dissection ordering from a MetisIndex, dissecting the two halves split by
+  /// each separator in parallel, see DissectionTree
+  static GTSAM_EXPORT Ordering NestedDissection(const MetisIndex& met);
+
+  template<class FACTOR_GRAPH>
+  static Ordering NestedDissection(const FACTOR_GRAPH& graph) {
+    return NestedDissection(MetisIndex(graph));
+  }
+
   /// @}
 
   /// @name Named Constructors @{
@@ -209,6 +268,8 @@ public:
       return Colamd(graph);
     case METIS:
       return Metis(graph);
+    case NESTED_DISSECTION:
+      return NestedDissection(graph);
     case NATURAL:
       return Natural(graph);
     case CUSTOM:
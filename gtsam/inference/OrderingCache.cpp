@@ -0,0 +1,76 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    OrderingCache.cpp
+ * @brief   Reuse of fill-reducing orderings across solves of evolving graphs
+ */
+
+#include <gtsam/inference/OrderingCache.h>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+OrderingCache::OrderingCache(size_t capacity, bool incremental,
+                             double maxAddedFraction)
+    : capacity_(capacity),
+      incremental_(incremental),
+      maxAddedFraction_(maxAddedFraction),
+      nrHits_(0),
+      nrIncremental_(0),
+      nrMisses_(0) {}
+
+/* ************************************************************************* */
+const Ordering* OrderingCache::lookup(size_t signature) {
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->signature == signature) {
+      entries_.splice(entries_.begin(), entries_, it);
+      return &entries_.front().ordering;
+    }
+  }
+  return 0;
+}
+
+/* ************************************************************************* */
+void OrderingCache::insert(size_t signature, Ordering::OrderingType type,
+                           const Ordering& ordering, size_t nrAdded) {
+  if (capacity_ == 0) return;
+  if (entries_.size() == capacity_) entries_.pop_back();
+  Entry entry = {signature, type, ordering, nrAdded};
+  entries_.push_front(entry);
+}
+
+/* ************************************************************************* */
+size_t OrderingCache::CountAdded(const Ordering& previous,
+                                 const Ordering& ordering) {
+  KeyVector previousKeys(previous.begin(), previous.end());
+  sort(previousKeys.begin(), previousKeys.end());
+  size_t count = 0;
+  for (Key key : ordering)
+    if (!binary_search(previousKeys.begin(), previousKeys.end(), key)) ++count;
+  return count;
+}
+
+/* ************************************************************************* */
+void OrderingCache::MoveToFront(const KeyVector& keys, Ordering* ordering) {
+  if (keys.empty()) return;
+  KeyVector sortedKeys(keys);
+  sort(sortedKeys.begin(), sortedKeys.end());
+  stable_partition(ordering->begin(), ordering->end(), [&](Key key) {
+    return binary_search(sortedKeys.begin(), sortedKeys.end(), key);
+  });
+}
+
+}  // namespace gtsam
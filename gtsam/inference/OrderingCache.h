@@ -0,0 +1,153 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    OrderingCache.h
+ * @brief   Reuse of fill-reducing orderings across solves of evolving graphs
+ */
+
+#pragma once
+
+#include <gtsam/inference/Ordering.h>
+
+#include <boost/functional/hash.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <list>
+
+namespace gtsam {
+
+/**
+ * A cache of fill-reducing orderings, keyed by the structure of the factor
+ * graph, i.e. the keys of every factor, so repeated solves of the same graph
+ * skip the ordering altogether.
+ *
+ * In incremental mode, a graph that is not in the cache is ordered by updating
+ * the most recently used ordering with Ordering::Incremental, which keeps the
+ * relative order of the variables that remain and appends the new ones.  A
+ * fresh ordering is computed once the variables appended since the last fresh
+ * one exceed a fraction of the graph, to keep fill-in in check.
+ *
+ * The cache is meant to be shared, e.g. through a boost::shared_ptr in the
+ * optimizer parameters, and is not thread-safe.
+ */
+class GTSAM_EXPORT OrderingCache {
+ public:
+  typedef boost::shared_ptr<OrderingCache> shared_ptr;
+
+ private:
+  struct Entry {
+    size_t signature;             ///< Signature of the graph and request
+    Ordering::OrderingType type;  ///< Type of the fresh ordering this derives from
+    Ordering ordering;
+    size_t nrAdded;  ///< Variables appended since the last fresh ordering
+  };
+
+  std::list<Entry> entries_;  ///< Most recently used first
+  size_t capacity_;
+  bool incremental_;
+  double maxAddedFraction_;
+  size_t nrHits_, nrIncremental_, nrMisses_;
+
+ public:
+  /**
+   * Create a cache holding up to \c capacity orderings.  If \c incremental is
+   * true, orderings of new graphs are updated from the most recent one as long
+   * as fewer than \c maxAddedFraction of the variables were appended since the
+   * last fresh ordering.
+   */
+  explicit OrderingCache(size_t capacity = 8, bool incremental = false,
+                         double maxAddedFraction = 0.1);
+
+  /**
+   * Return an ordering of \c graph of the given type, with the variables in
+   * \c constrainFirst first, from the cache if possible.  COLAMD orderings
+   * are constrained with CCOLAMD, the others by moving the variables in
+   * \c constrainFirst to the front.
+   */
+  template <class FACTOR_GRAPH>
+  Ordering create(Ordering::OrderingType type, const FACTOR_GRAPH& graph,
+                  const KeyVector& constrainFirst = KeyVector()) {
+    if (graph.empty() || type == Ordering::CUSTOM)
+      return Ordering::Create(type, graph);
+
+    size_t signature = Signature(graph);
+    boost::hash_combine(signature, static_cast<int>(type));
+    boost::hash_range(signature, constrainFirst.begin(), constrainFirst.end());
+    if (const Ordering* cached = lookup(signature)) {
+      ++nrHits_;
+      return *cached;
+    }
+
+    if (incremental_ && !entries_.empty() && entries_.front().type == type) {
+      const Entry& previous = entries_.front();
+      Ordering ordering = Ordering::Incremental(graph, previous.ordering);
+      const size_t nrAdded =
+          previous.nrAdded + CountAdded(previous.ordering, ordering);
+      if (nrAdded <= maxAddedFraction_ * ordering.size()) {
+        ++nrIncremental_;
+        MoveToFront(constrainFirst, &ordering);
+        insert(signature, type, ordering, nrAdded);
+        return ordering;
+      }
+    }
+
+    ++nrMisses_;
+    Ordering ordering = (type == Ordering::COLAMD && !constrainFirst.empty())
+        ? Ordering::ColamdConstrainedFirst(graph, constrainFirst)
+        : Ordering::Create(type, graph);
+    MoveToFront(constrainFirst, &ordering);
+    insert(signature, type, ordering, 0);
+    return ordering;
+  }
+
+  /// Hash of the keys of all factors, in order, identifying the graph structure
+  template <class FACTOR_GRAPH>
+  static size_t Signature(const FACTOR_GRAPH& graph) {
+    size_t seed = graph.size();
+    for (const auto& factor : graph) {
+      if (factor) boost::hash_range(seed, factor->begin(), factor->end());
+      boost::hash_combine(seed, factor ? factor->size() : 0);
+    }
+    return seed;
+  }
+
+  /// Remove all orderings
+  void clear() { entries_.clear(); }
+
+  /// Number of orderings in the cache
+  size_t size() const { return entries_.size(); }
+
+  /// Number of requests answered from the cache
+  size_t nrHits() const { return nrHits_; }
+
+  /// Number of requests answered by updating a previous ordering
+  size_t nrIncremental() const { return nrIncremental_; }
+
+  /// Number of requests that needed a fresh ordering
+  size_t nrMisses() const { return nrMisses_; }
+
+ private:
+  /// Find an ordering by signature, and mark it as most recently used
+  const Ordering* lookup(size_t signature);
+
+  /// Add an ordering as the most recently used one, evicting the oldest
+  void insert(size_t signature, Ordering::OrderingType type,
+              const Ordering& ordering, size_t nrAdded);
+
+  /// Number of variables in \c ordering that are not in \c previous
+  static size_t CountAdded(const Ordering& previous, const Ordering& ordering);
+
+  /// Stably move the given variables to the front of the ordering
+  static void MoveToFront(const KeyVector& keys, Ordering* ordering);
+};
+
+}  // namespace gtsam
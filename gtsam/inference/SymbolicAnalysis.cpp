@@ -0,0 +1,178 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SymbolicAnalysis.cpp
+ * @brief   Elimination tree and conditional sizes without symbolic elimination
+ */
+
+#include <gtsam/inference/SymbolicAnalysis.h>
+#include <gtsam/base/timing.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+using namespace std;
+
+namespace gtsam {
+
+const size_t SymbolicAnalysis::None = numeric_limits<size_t>::max();
+
+namespace {
+/* ************************************************************************* */
+// Determines whether variable j is a leaf of the row subtree of i, and if it is
+// a subsequent leaf, returns the least common ancestor q of j and the previous
+// leaf. Mirrors cs_leaf from CSparse, -1 stands for none.
+ptrdiff_t Leaf(ptrdiff_t i, ptrdiff_t j, const FastVector<ptrdiff_t>& first,
+               FastVector<ptrdiff_t>& maxfirst, FastVector<ptrdiff_t>& prevleaf,
+               FastVector<ptrdiff_t>& ancestor, int* jleaf) {
+  *jleaf = 0;
+  if (i <= j || first[j] <= maxfirst[i]) return -1;  // j is not a leaf
+  maxfirst[i] = first[j];
+  const ptrdiff_t jprev = prevleaf[i];
+  prevleaf[i] = j;
+  *jleaf = (jprev == -1) ? 1 : 2;
+  if (*jleaf == 1) return i;  // first leaf, q is the root of the row subtree
+  ptrdiff_t q = jprev;
+  while (q != ancestor[q]) q = ancestor[q];
+  for (ptrdiff_t s = jprev, sparent; s != q; s = sparent) {
+    sparent = ancestor[s];  // path compression
+    ancestor[s] = q;
+  }
+  return q;
+}
+}  // namespace
+
+/* ************************************************************************* */
+SymbolicAnalysis::SymbolicAnalysis(size_t n,
+                                   const FastVector<size_t>& factorStarts,
+                                   const FastVector<size_t>& variables) {
+  gttic(SymbolicAnalysis);
+  const size_t m = factorStarts.empty() ? 0 : factorStarts.size() - 1;
+
+  // Transpose, to find the factors of each variable
+  FastVector<size_t> variableStarts(n + 1, 0), factors(variables.size());
+  for (size_t j : variables) ++variableStarts[j + 1];
+  partial_sum(variableStarts.begin(), variableStarts.end(), variableStarts.begin());
+  {
+    FastVector<size_t> next(variableStarts.begin(), variableStarts.end() - 1);
+    for (size_t i = 0; i < m; ++i)
+      for (size_t p = factorStarts[i]; p < factorStarts[i + 1]; ++p)
+        factors[next[variables[p]]++] = i;
+  }
+
+  // Elimination tree, with Liu's algorithm. The last variable seen of each
+  // factor connects the current variable to the subtree containing it, whose
+  // root we find with path compression.
+  gttic(etree);
+  parents_.assign(n, None);
+  {
+    FastVector<size_t> ancestor(n, None), previous(m, None);
+    for (size_t k = 0; k < n; ++k) {
+      for (size_t p = variableStarts[k]; p < variableStarts[k + 1]; ++p) {
+        const size_t i = factors[p];
+        for (size_t j = previous[i], next; j != None && j < k; j = next) {
+          next = ancestor[j];
+          ancestor[j] = k;
+          if (next == None) parents_[j] = k;
+        }
+        previous[i] = k;
+      }
+    }
+  }
+  gttoc(etree);
+
+  // Postorder, visiting children in increasing order
+  gttic(postorder);
+  postorder_.reserve(n);
+  {
+    FastVector<size_t> head(n, None), next(n, None), stack;
+    for (size_t j = n; j-- > 0;) {
+      if (parents_[j] != None) {
+        next[j] = head[parents_[j]];
+        head[parents_[j]] = j;
+      }
+    }
+    for (size_t root = 0; root < n; ++root) {
+      if (parents_[root] != None) continue;
+      stack.push_back(root);
+      while (!stack.empty()) {
+        const size_t p = stack.back(), child = head[p];
+        if (child == None) {
+          stack.pop_back();
+          postorder_.push_back(p);
+        } else {
+          head[p] = next[child];
+          stack.push_back(child);
+        }
+      }
+    }
+  }
+  gttoc(postorder);
+
+  // Column counts, with the algorithm of Gilbert, Ng and Peyton (cs_counts):
+  // delta[j] counts the row subtrees in which j is a leaf, minus overlaps
+  gttic(column_counts);
+  const ptrdiff_t none = -1;
+  FastVector<ptrdiff_t> parent(n), delta(n), first(n, none), maxfirst(n, none),
+      prevleaf(n, none), ancestor(n), position(n);
+  for (size_t j = 0; j < n; ++j)
+    parent[j] = (parents_[j] == None) ? none : ptrdiff_t(parents_[j]);
+  for (size_t k = 0; k < n; ++k) {
+    ptrdiff_t j = postorder_[k];
+    position[j] = k;
+    delta[j] = (first[j] == none) ? 1 : 0;  // delta is 1 for leaves
+    for (; j != none && first[j] == none; j = parent[j]) first[j] = k;
+  }
+
+  // Each factor is a dense row in A'A: process it at the first of its
+  // variables in postorder
+  FastVector<ptrdiff_t> factorHead(n, none), factorNext(m, none);
+  for (size_t i = 0; i < m; ++i) {
+    ptrdiff_t k = n;
+    for (size_t p = factorStarts[i]; p < factorStarts[i + 1]; ++p)
+      k = min(k, position[variables[p]]);
+    if (k < ptrdiff_t(n)) {
+      factorNext[i] = factorHead[k];
+      factorHead[k] = i;
+    }
+  }
+
+  for (size_t j = 0; j < n; ++j) ancestor[j] = j;
+  for (size_t k = 0; k < n; ++k) {
+    const ptrdiff_t j = postorder_[k];
+    if (parent[j] != none) delta[parent[j]]--;  // j is not a root
+    for (ptrdiff_t i = factorHead[k]; i != none; i = factorNext[i]) {
+      for (size_t p = factorStarts[i]; p < factorStarts[i + 1]; ++p) {
+        int jleaf;
+        const ptrdiff_t q = Leaf(variables[p], j, first, maxfirst, prevleaf,
+                                 ancestor, &jleaf);
+        if (jleaf >= 1) delta[j]++;  // (i, j) is in the skeleton
+        if (jleaf == 2) delta[q]--;  // account for overlap in q
+      }
+    }
+    if (parent[j] != none) ancestor[j] = parent[j];
+  }
+
+  // Sum up the deltas of each subtree, parents come after their children
+  for (size_t j = 0; j < n; ++j)
+    if (parent[j] != none) delta[parent[j]] += delta[j];
+  columnCounts_.assign(delta.begin(), delta.end());
+  gttoc(column_counts);
+}
+
+/* ************************************************************************* */
+size_t SymbolicAnalysis::nnz() const {
+  return accumulate(columnCounts_.begin(), columnCounts_.end(), size_t(0));
+}
+
+}  // namespace gtsam
@@ -0,0 +1,72 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SymbolicAnalysis.h
+ * @brief   Elimination tree and conditional sizes without symbolic elimination
+ */
+
+#pragma once
+
+#include <gtsam/base/FastVector.h>
+#include <gtsam/dllexport.h>
+
+#include <cstddef>
+
+namespace gtsam {
+
+/**
+ * Symbolic analysis of the elimination of a factor graph: computes the
+ * elimination tree, and the number of variables in every conditional, without
+ * doing any symbolic elimination. The factor graph is given as the variables
+ * of each factor, numbered in elimination order, i.e., as the sparsity pattern
+ * of a matrix A with one row per factor, and the analysis is that of the
+ * Cholesky factor of A'A:
+ *  - the elimination tree is found with Liu's algorithm, using path
+ *    compression, and
+ *  - the column counts with the algorithm of Gilbert, Ng and Peyton, which
+ *    finds the leaves of the row subtrees of the factor.
+ * Both take time nearly linear in the number of nonzeros of A. See T. Davis,
+ * "Direct Methods for Sparse Linear Systems", SIAM, 2006, chapter 4.
+ */
+class GTSAM_EXPORT SymbolicAnalysis {
+ public:
+  /// Parent of a root of the elimination tree
+  static const size_t None;
+
+ private:
+  FastVector<size_t> parents_;
+  FastVector<size_t> postorder_;
+  FastVector<size_t> columnCounts_;
+
+ public:
+  /**
+   * Analyze the elimination of \c nrVariables variables, numbered in
+   * elimination order. The variables of factor i are
+   * variables[factorStarts[i]] to variables[factorStarts[i+1]-1].
+   */
+  SymbolicAnalysis(size_t nrVariables, const FastVector<size_t>& factorStarts,
+                   const FastVector<size_t>& variables);
+
+  /// The elimination tree parent of each variable, or None for roots
+  const FastVector<size_t>& parents() const { return parents_; }
+
+  /// The variables in a postorder of the elimination tree
+  const FastVector<size_t>& postorder() const { return postorder_; }
+
+  /// The number of variables in the conditional on each variable, itself included
+  const FastVector<size_t>& columnCounts() const { return columnCounts_; }
+
+  /// The number of variable entries in the Bayes net, the sum of the column counts
+  size_t nnz() const;
+};
+
+}  // namespace gtsam
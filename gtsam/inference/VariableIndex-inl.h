@@ -20,6 +20,8 @@
 #include <gtsam/inference/VariableIndex.h>
 #include <gtsam/base/timing.h>
 
+#include <algorithm>
+
 namespace gtsam {
 
 /* ************************************************************************* */
@@ -28,15 +30,16 @@ void VariableIndex::augment(const FG& factors,
     boost::optional<const FactorIndices&> newFactorIndices) {
   gttic(VariableIndex_augment);
 
-  // Augment index for each factor
+  // Gather the new entries, and sort them by key so that each variable is
+  // looked up, and its segment grown, only once. The sort is stable to keep
+  // the factors of each variable in the order they were added.
+  std::vector<std::pair<Key, FactorIndex> > entries;
   for (size_t i = 0; i < factors.size(); ++i) {
     if (factors[i]) {
       const size_t globalI =
           newFactorIndices ? (*newFactorIndices)[i] : nFactors_;
-      for(const Key key: *factors[i]) {
-        index_[key].push_back(globalI);
-        ++nEntries_;
-      }
+      for(const Key key: *factors[i])
+        entries.push_back(std::make_pair(key, globalI));
     }
 
     // Increment factor count even if factors are null, to keep indices consistent
@@ -47,6 +50,11 @@ void VariableIndex::augment(const FG& factors,
       ++nFactors_;
     }
   }
+  std::stable_sort(entries.begin(), entries.end(),
+      [](const std::pair<Key, FactorIndex>& a, const std::pair<Key, FactorIndex>& b) {
+        return a.first < b.first;
+      });
+  append(entries);
 }
 
 /* ************************************************************************* */
@@ -67,13 +75,16 @@ void VariableIndex::remove(ITERATOR firstFactor, ITERATOR lastFactor,
           "Internal error, requested inconsistent number of factor indices and factors in VariableIndex::remove");
     if (factors[i]) {
       for(Key j: *factors[i]) {
-        FactorIndices& factorEntries = internalAt(j);
-        auto entry = std::find(factorEntries.begin(),
-            factorEntries.end(), *factorIndex);
-        if (entry == factorEntries.end())
+        // Close the gap within the segment, the freed entry becomes slack
+        Row& row = internalAt(j);
+        const FactorIndices::iterator first = entries_.begin() + row.offset,
+            last = first + row.size;
+        const FactorIndices::iterator entry = std::find(first, last, *factorIndex);
+        if (entry == last)
           throw std::invalid_argument(
               "Internal error, indices and factors passed into VariableIndex::remove are not consistent with the existing variable index");
-        factorEntries.erase(entry);
+        std::copy(entry + 1, last, entry);
+        --row.size;
         --nEntries_;
       }
     }
@@ -85,11 +96,14 @@ template<typename ITERATOR>
 void VariableIndex::removeUnusedVariables(ITERATOR firstKey, ITERATOR lastKey) {
   for (ITERATOR key = firstKey; key != lastKey; ++key) {
     KeyMap::iterator entry = index_.find(*key);
-    if (!entry->second.empty())
+    if (entry->second.size != 0)
       throw std::invalid_argument(
           "Asking to remove variables from the variable index that are not unused");
+    nUnused_ += entry->second.capacity;
     index_.erase(entry);
   }
+  if (2 * nUnused_ > entries_.size())
+    compact();
 }
 
 }
@@ -15,25 +15,37 @@
  * @date    March 26, 2013
  */
 
-#include <iostream>
-
 #include <gtsam/inference/VariableIndex.h>
 
+#include <algorithm>
+#include <iostream>
+
 namespace gtsam {
 
 using namespace std;
 
 /* ************************************************************************* */
 bool VariableIndex::equals(const VariableIndex& other, double tol) const {
-  return this->nEntries_ == other.nEntries_ && this->nFactors_ == other.nFactors_
-    && this->index_ == other.index_;
+  if (this->nEntries_ != other.nEntries_ || this->nFactors_ != other.nFactors_
+      || this->size() != other.size())
+    return false;
+  // Compare the factors of each variable, regardless of where they are stored
+  for (const_iterator it1 = begin(), it2 = other.begin(); it1 != end(); ++it1, ++it2) {
+    const value_type key_factors1 = *it1, key_factors2 = *it2;
+    if (key_factors1.first != key_factors2.first
+        || key_factors1.second.size() != key_factors2.second.size()
+        || !std::equal(key_factors1.second.begin(), key_factors1.second.end(),
+                       key_factors2.second.begin()))
+      return false;
+  }
+  return true;
 }
 
 /* ************************************************************************* */
 void VariableIndex::print(const string& str, const KeyFormatter& keyFormatter) const {
   cout << str;
   cout << "nEntries = " << nEntries() << ", nFactors = " << nFactors() << "\n";
-  for(KeyMap::value_type key_factors: index_) {
+  for(const value_type key_factors: *this) {
     cout << "var " << keyFormatter(key_factors.first) << ":";
     for(const auto index: key_factors.second)
       cout << " " << index;
@@ -46,7 +58,7 @@ void VariableIndex::print(const string& str, const KeyFormatter& keyFormatter) c
 void VariableIndex::outputMetisFormat(ostream& os) const {
   os << size() << " " << nFactors() << "\n";
   // run over variables, which will be hyper-edges.
-  for(KeyMap::value_type key_factors: index_) {
+  for(const value_type key_factors: *this) {
     // every variable is a hyper-edge covering its factors
     for(const auto index: key_factors.second)
       os << (index+1) << " "; // base 1
@@ -60,12 +72,77 @@ void VariableIndex::augmentExistingFactor(const FactorIndex factorIndex, const K
 {
   gttic(VariableIndex_augmentExistingFactor);
 
-  for(const Key key: newKeys) {
-    index_[key].push_back(factorIndex);
-    ++nEntries_;
-  }
+  vector<pair<Key, FactorIndex> > entries;
+  entries.reserve(newKeys.size());
+  for(const Key key: newKeys)
+    entries.push_back(make_pair(key, factorIndex));
+  append(entries);
 
   gttoc(VariableIndex_augmentExistingFactor);
 }
 
+/* ************************************************************************* */
+void VariableIndex::append(const vector<pair<Key, FactorIndex> >& entries) {
+  // A new index is laid out exactly, in key order
+  if (index_.empty())
+    entries_.reserve(entries.size());
+
+  KeyMap::iterator hint = index_.begin();
+  for (size_t begin = 0, end = 0; begin < entries.size(); begin = end) {
+    const Key key = entries[begin].first;
+    while (end < entries.size() && entries[end].first == key)
+      ++end;
+
+    // Keys are sorted, so the hint makes finding or creating the entry cheap
+    hint = index_.insert(hint, make_pair(key, Row()));
+    Row& row = hint->second;
+    ++hint;
+    reserve(row, row.size + (end - begin));
+    for (size_t k = begin; k < end; ++k)
+      entries_[row.offset + row.size++] = entries[k].second;
+    nEntries_ += end - begin;
+  }
+}
+
+/* ************************************************************************* */
+void VariableIndex::reserve(Row& row, size_t capacity) {
+  if (capacity <= row.capacity)
+    return;
+  capacity = max(capacity, 2 * row.capacity);
+
+  // The last segment can simply extend the array
+  if (row.offset + row.capacity == entries_.size()) {
+    entries_.resize(row.offset + capacity);
+    row.capacity = capacity;
+    return;
+  }
+
+  // Otherwise move the segment to the end of the array
+  if (2 * nUnused_ > entries_.size())
+    compact();
+  const size_t offset = entries_.size();
+  entries_.resize(offset + capacity);
+  copy(entries_.begin() + row.offset, entries_.begin() + row.offset + row.size,
+       entries_.begin() + offset);
+  nUnused_ += row.capacity;
+  row.offset = offset;
+  row.capacity = capacity;
+}
+
+/* ************************************************************************* */
+void VariableIndex::compact() {
+  gttic(VariableIndex_compact);
+  FactorIndices entries;
+  entries.reserve(entries_.size() - nUnused_);
+  for (KeyMap::value_type& key_row : index_) {
+    Row& row = key_row.second;
+    const size_t offset = entries.size();
+    entries.insert(entries.end(), entries_.begin() + row.offset,
+                   entries_.begin() + row.offset + row.capacity);
+    row.offset = offset;
+  }
+  entries_.swap(entries);
+  nUnused_ = 0;
+}
+
 }
@@ -23,11 +23,14 @@
 #include <gtsam/base/FastVector.h>
 #include <gtsam/dllexport.h>
 
+#include <boost/iterator/transform_iterator.hpp>
 #include <boost/optional/optional.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
 
 #include <cassert>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace gtsam {
 
@@ -36,39 +39,97 @@ namespace gtsam {
  * factor graph.  The factor graph stores a collection of factors, each of
  * which involves a set of variables.  In contrast, the VariableIndex is built
  * from a factor graph prior to elimination, and stores the list of factors
- * that involve each variable.  This information is stored as a deque of
- * lists of factor indices.
+ * that involve each variable.
+ *
+ * The lists are stored in compressed sparse row (CSR) form: the factor indices
+ * of all variables live in one contiguous array, and each variable owns a
+ * segment of it, with some slack at the end so that augmenting with new
+ * factors is amortized constant time. A segment that runs out of slack moves
+ * to the end of the array, and the segments of removed variables are left
+ * behind as dead space, which is reclaimed once it makes up half the array.
+ * Copying a VariableIndex thus copies two flat arrays, and orderings such as
+ * COLAMD read the structure with a single sequential pass.
+ *
+ * The Factors returned by operator[] and by iteration are views into this
+ * array, and are invalidated by any modification of the VariableIndex.
  * \nosubgrouping
  */
 class GTSAM_EXPORT VariableIndex {
  public:
   typedef boost::shared_ptr<VariableIndex> shared_ptr;
-  typedef FactorIndices::iterator Factor_iterator;
-  typedef FactorIndices::const_iterator Factor_const_iterator;
+  typedef const FactorIndex* Factor_iterator;
+  typedef const FactorIndex* Factor_const_iterator;
+
+  /// The indices of the factors involving one variable, a view into the VariableIndex
+  class Factors {
+    const FactorIndex* begin_;
+    const FactorIndex* end_;
+
+   public:
+    typedef FactorIndex value_type;
+    typedef const FactorIndex* iterator;
+    typedef const FactorIndex* const_iterator;
+
+    Factors(const FactorIndex* begin, const FactorIndex* end)
+        : begin_(begin), end_(end) {}
+
+    const_iterator begin() const { return begin_; }
+    const_iterator end() const { return end_; }
+    size_t size() const { return end_ - begin_; }
+    bool empty() const { return begin_ == end_; }
+    FactorIndex operator[](size_t i) const { return begin_[i]; }
+    FactorIndex front() const { return *begin_; }
+    FactorIndex back() const { return *(end_ - 1); }
+  };
 
  protected:
-  typedef FastMap<Key, FactorIndices> KeyMap;
+  /// The segment of entries_ owned by one variable
+  struct Row {
+    size_t offset;    ///< Start of the segment in entries_
+    size_t size;      ///< Number of factor indices in the segment
+    size_t capacity;  ///< Length of the segment, including slack
+    Row() : offset(0), size(0), capacity(0) {}
+  };
+
+  typedef FastMap<Key, Row> KeyMap;
   KeyMap index_;
+  FactorIndices entries_;  // Factor indices of all variables, segment by segment
+  size_t nUnused_;   // Entries in entries_ that belong to no variable's segment
   size_t nFactors_;  // Number of factors in the original factor graph.
   size_t nEntries_;  // Sum of involved variable counts of each factor.
 
+  /// Creates the (Key, Factors) pairs the iterators point to
+  struct MakeKeyFactors {
+    typedef std::pair<Key, Factors> result_type;
+    const FactorIndex* entries;
+    explicit MakeKeyFactors(const FactorIndex* entries) : entries(entries) {}
+    result_type operator()(const KeyMap::value_type& key_row) const {
+      const Row& row = key_row.second;
+      return result_type(key_row.first, Factors(entries + row.offset,
+                                                entries + row.offset + row.size));
+    }
+  };
+
  public:
-  typedef KeyMap::const_iterator const_iterator;
-  typedef KeyMap::const_iterator iterator;
-  typedef KeyMap::value_type value_type;
+  /// Iterators dereference to (Key, Factors) pairs by value, so adaptors such
+  /// as boost::adaptors::map_keys, which return references into them, dangle.
+  typedef boost::transform_iterator<MakeKeyFactors, KeyMap::const_iterator> const_iterator;
+  typedef const_iterator iterator;
+  typedef std::pair<Key, Factors> value_type;
 
   /// @name Standard Constructors
   /// @{
 
   /// Default constructor, creates an empty VariableIndex
-  VariableIndex() : nFactors_(0), nEntries_(0) {}
+  VariableIndex() : nUnused_(0), nFactors_(0), nEntries_(0) {}
 
   /**
    * Create a VariableIndex that computes and stores the block column structure
    * of a factor graph.
    */
   template <class FG>
-  explicit VariableIndex(const FG& factorGraph) : nFactors_(0), nEntries_(0) {
+  explicit VariableIndex(const FG& factorGraph)
+      : nUnused_(0), nFactors_(0), nEntries_(0) {
     augment(factorGraph);
   }
 
@@ -86,12 +147,12 @@ class GTSAM_EXPORT VariableIndex {
   size_t nEntries() const { return nEntries_; }
 
   /// Access a list of factors by variable
-  const FactorIndices& operator[](Key variable) const {
+  Factors operator[](Key variable) const {
     KeyMap::const_iterator item = index_.find(variable);
     if(item == index_.end())
       throw std::invalid_argument("Requested non-existent variable from VariableIndex");
     else
-    return item->second;
+    return factors(item->second);
   }
 
   /// Return true if no factors associated with a variable
@@ -152,31 +213,49 @@ class GTSAM_EXPORT VariableIndex {
   template<typename ITERATOR>
   void removeUnusedVariables(ITERATOR firstKey, ITERATOR lastKey);
 
+  /**
+   * Reclaim the dead space left behind by moved and removed segments, and lay
+   * out the segments in key order. This happens automatically once half of the
+   * storage is dead, but may be called before a batch of orderings.
+   */
+  void compact();
+
   /// Iterator to the first variable entry
-  const_iterator begin() const { return index_.begin(); }
+  const_iterator begin() const { return makeIterator(index_.begin()); }
 
   /// Iterator to the first variable entry
-  const_iterator end() const { return index_.end(); }
+  const_iterator end() const { return makeIterator(index_.end()); }
 
   /// Find the iterator for the requested variable entry
-  const_iterator find(Key key) const { return index_.find(key); }
+  const_iterator find(Key key) const { return makeIterator(index_.find(key)); }
 
 protected:
-  Factor_iterator factorsBegin(Key variable) { return internalAt(variable).begin(); }
-  Factor_iterator factorsEnd(Key variable) { return internalAt(variable).end(); }
+  /// The factors in a segment
+  Factors factors(const Row& row) const {
+    const FactorIndex* entries = entries_.data() + row.offset;
+    return Factors(entries, entries + row.size);
+  }
+
+  /// Wrap an iterator into index_
+  const_iterator makeIterator(KeyMap::const_iterator it) const {
+    return const_iterator(it, MakeKeyFactors(entries_.data()));
+  }
+
+  /// Make room for \c capacity factor indices in a segment, moving it to the end of entries_ if needed
+  void reserve(Row& row, size_t capacity);
 
-  Factor_const_iterator factorsBegin(Key variable) const { return internalAt(variable).begin(); }
-  Factor_const_iterator factorsEnd(Key variable) const { return internalAt(variable).end(); }
+  /// Append (Key, factor index) pairs, sorted by key, to the segments of their variables
+  void append(const std::vector<std::pair<Key, FactorIndex> >& entries);
 
   /// Internal version of 'at' that asserts existence
-  const FactorIndices& internalAt(Key variable) const {
+  const Row& internalAt(Key variable) const {
     const KeyMap::const_iterator item = index_.find(variable);
     assert(item != index_.end());
     return item->second; 
   }
 
   /// Internal version of 'at' that asserts existence
-  FactorIndices& internalAt(Key variable) {
+  Row& internalAt(Key variable) {
     const KeyMap::iterator item = index_.find(variable);
     assert(item != index_.end());
     return item->second; 
@@ -0,0 +1,113 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testDissectionTree.cpp
+ * @brief   Unit tests for DissectionTree
+ */
+
+#include <gtsam/inference/DissectionTree.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/symbolic/SymbolicBayesTree.h>
+#include <gtsam/symbolic/SymbolicConditional.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace gtsam;
+
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+namespace {
+// An n x n grid with a prior in the corner
+SymbolicFactorGraph grid(size_t n) {
+  SymbolicFactorGraph graph;
+  graph.push_factor(0);
+  for (size_t i = 0; i < n; ++i)
+    for (size_t j = 0; j < n; ++j) {
+      const Key key = i * n + j;
+      if (j + 1 < n) graph.push_factor(key, key + 1);
+      if (i + 1 < n) graph.push_factor(key, key + n);
+    }
+  return graph;
+}
+
+// The variables of a subtree of the dissection
+KeySet subtreeKeys(const DissectionTree::sharedNode& node) {
+  KeySet keys(node->keys.begin(), node->keys.end());
+  for (const DissectionTree::sharedNode& child : node->children) {
+    const KeySet childKeys = subtreeKeys(child);
+    keys.insert(childKeys.begin(), childKeys.end());
+  }
+  return keys;
+}
+
+// Whether the separator of every node splits the graph, and leaves are small
+bool separates(const DissectionTree::sharedNode& node,
+               const SymbolicFactorGraph& graph, size_t leafSize) {
+  if (node->children.empty()) return node->keys.size() <= leafSize;
+  if (node->children.size() != 2) return false;
+  const KeySet first = subtreeKeys(node->children[0]),
+               second = subtreeKeys(node->children[1]);
+  for (const SymbolicFactor::shared_ptr& factor : graph) {
+    bool inFirst = false, inSecond = false;
+    for (Key key : *factor) {
+      inFirst = inFirst || first.exists(key);
+      inSecond = inSecond || second.exists(key);
+    }
+    if (inFirst && inSecond) return false;
+  }
+  return separates(node->children[0], graph, leafSize) &&
+         separates(node->children[1], graph, leafSize);
+}
+}
+
+/* ************************************************************************* */
+TEST(DissectionTree, grid) {
+  const SymbolicFactorGraph graph = grid(20);
+  const DissectionTree tree(graph, 16);
+  EXPECT(!tree.root()->keys.empty());
+  EXPECT(separates(tree.root(), graph, 16));
+
+  // The ordering contains every variable once
+  const Ordering ordering = tree.ordering();
+  const KeySet keys = graph.keys();
+  LONGS_EQUAL(keys.size(), ordering.size());
+  EXPECT(is_permutation(ordering.begin(), ordering.end(), keys.begin()));
+
+  // The root separator is eliminated last, in the root clique
+  const SymbolicBayesTree bayesTree = *graph.eliminateMultifrontal(ordering);
+  LONGS_EQUAL(1, bayesTree.roots().size());
+  const SymbolicConditional& root = *bayesTree.roots().front()->conditional();
+  for (Key key : tree.root()->keys)
+    EXPECT(find(root.beginFrontals(), root.endFrontals(), key) != root.endFrontals());
+
+  // Same variables as Ordering::Create
+  const Ordering created = Ordering::Create(Ordering::NESTED_DISSECTION, graph);
+  EXPECT(is_permutation(created.begin(), created.end(), keys.begin()));
+}
+
+/* ************************************************************************* */
+TEST(DissectionTree, small) {
+  // A graph smaller than a leaf is ordered by METIS as a whole
+  SymbolicFactorGraph graph;
+  graph.push_factor(0, 1);
+  graph.push_factor(1, 2);
+  const DissectionTree tree(graph);
+  EXPECT(tree.root()->children.empty());
+  LONGS_EQUAL(3, tree.ordering().size());
+}
+#endif
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
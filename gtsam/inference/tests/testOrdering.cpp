@@ -327,6 +327,30 @@ TEST(Ordering, Create) {
   CHECK_EXCEPTION(Ordering::Create(Ordering::CUSTOM, symbolicGraph), runtime_error);
 }
 
+/* ************************************************************************* */
+TEST(Ordering, Incremental) {
+  // Variable 0 has left the chain, variable 5 has joined it
+  SymbolicFactorGraph graph;
+  graph.push_factor(1, 2);
+  graph.push_factor(2, 3);
+  graph.push_factor(3, 4);
+  graph.push_factor(4, 5);
+
+  // The remaining variables keep their previous order, the new one comes last
+  Ordering previous = Ordering(list_of(4)(3)(2)(1)(0));
+  Ordering expected = Ordering(list_of(4)(3)(2)(1)(5));
+  EXPECT(assert_equal(expected, Ordering::Incremental(graph, previous)));
+
+  // Nothing new
+  previous = Ordering(list_of(5)(4)(3)(2)(1)(0));
+  expected = Ordering(list_of(5)(4)(3)(2)(1));
+  EXPECT(assert_equal(expected, Ordering::Incremental(graph, previous)));
+
+  // Nothing previous amounts to COLAMD
+  EXPECT(assert_equal(Ordering::Colamd(graph),
+                      Ordering::Incremental(graph, Ordering())));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
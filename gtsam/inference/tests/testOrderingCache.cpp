@@ -0,0 +1,103 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testOrderingCache.cpp
+ * @brief   Unit tests for OrderingCache
+ */
+
+#include <gtsam/inference/OrderingCache.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+// A chain over keys first..last, with a prior on first
+SymbolicFactorGraph chain(Key first, Key last) {
+  SymbolicFactorGraph graph;
+  graph.push_factor(first);
+  for (Key key = first; key < last; ++key) graph.push_factor(key, key + 1);
+  return graph;
+}
+
+// Whether the ordering contains exactly the keys of the graph
+bool isPermutation(const Ordering& ordering, const SymbolicFactorGraph& graph) {
+  const KeySet keys = graph.keys();
+  return ordering.size() == keys.size() &&
+         is_permutation(ordering.begin(), ordering.end(), keys.begin());
+}
+}
+
+/* ************************************************************************* */
+TEST(OrderingCache, hits) {
+  OrderingCache cache(2);
+  const SymbolicFactorGraph graph1 = chain(0, 10), graph2 = chain(0, 11),
+                            graph3 = chain(5, 10);
+
+  const Ordering ordering1 = cache.create(Ordering::COLAMD, graph1);
+  EXPECT(assert_equal(Ordering::Colamd(graph1), ordering1));
+  EXPECT(assert_equal(ordering1, cache.create(Ordering::COLAMD, graph1)));
+  LONGS_EQUAL(1, cache.nrHits());
+  LONGS_EQUAL(1, cache.nrMisses());
+
+  // Same structure, different request
+  const KeyVector first(1, 9);
+  const Ordering constrained = cache.create(Ordering::COLAMD, graph1, first);
+  EXPECT(assert_equal(Ordering::ColamdConstrainedFirst(graph1, first),
+                      constrained));
+  LONGS_EQUAL(2, cache.nrMisses());
+
+  // Evict the least recently used ordering
+  cache.create(Ordering::COLAMD, graph2);
+  LONGS_EQUAL(2, cache.size());
+  cache.create(Ordering::COLAMD, graph1, first);
+  cache.create(Ordering::COLAMD, graph1);
+  LONGS_EQUAL(2, cache.nrHits());
+  LONGS_EQUAL(4, cache.nrMisses());
+
+  cache.create(Ordering::NATURAL, graph3);
+  EXPECT(assert_equal(Ordering::Natural(graph3),
+                      cache.create(Ordering::NATURAL, graph3)));
+  LONGS_EQUAL(0, cache.nrIncremental());
+
+  cache.clear();
+  LONGS_EQUAL(0, cache.size());
+}
+
+/* ************************************************************************* */
+TEST(OrderingCache, incremental) {
+  // Slide a window of 20 variables along a chain
+  OrderingCache cache(1, true, 0.1);
+  for (Key last = 20; last < 60; ++last) {
+    const SymbolicFactorGraph graph = chain(last - 19, last);
+    const KeyVector first(1, last - 19);
+    const size_t nrIncremental = cache.nrIncremental();
+    const Ordering ordering = cache.create(Ordering::COLAMD, graph, first);
+    EXPECT(isPermutation(ordering, graph));
+    EXPECT(ordering.front() == last - 19);
+    if (cache.nrIncremental() > nrIncremental)
+      EXPECT(ordering.back() == last);  // the new variable comes last
+  }
+  // A fresh ordering is computed once more than 10% (two variables) were
+  // appended, so every third time
+  LONGS_EQUAL(26, cache.nrIncremental());
+  LONGS_EQUAL(14, cache.nrMisses());
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
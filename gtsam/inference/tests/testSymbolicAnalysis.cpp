@@ -0,0 +1,132 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testSymbolicAnalysis.cpp
+ * @brief   Unit tests for SymbolicAnalysis
+ */
+
+#include <gtsam/inference/SymbolicAnalysis.h>
+#include <gtsam/symbolic/SymbolicFactorGraph.h>
+#include <gtsam/symbolic/SymbolicBayesNet.h>
+#include <gtsam/symbolic/SymbolicConditional.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/assign/std/vector.hpp>
+#include <boost/random.hpp>
+
+using namespace std;
+using namespace gtsam;
+using namespace boost::assign;
+
+namespace {
+// Analyze a graph on keys 0..n-1, eliminated in natural order
+SymbolicAnalysis analyze(size_t n, const SymbolicFactorGraph& graph) {
+  FastVector<size_t> factorStarts(1, 0), variables;
+  for (const SymbolicFactor::shared_ptr& factor : graph) {
+    variables.insert(variables.end(), factor->begin(), factor->end());
+    factorStarts.push_back(variables.size());
+  }
+  return SymbolicAnalysis(n, factorStarts, variables);
+}
+
+// Whether the analysis agrees with symbolic elimination in natural order
+bool agrees(size_t n, const SymbolicFactorGraph& graph) {
+  const SymbolicAnalysis analysis = analyze(n, graph);
+  const Ordering ordering = Ordering::Natural(graph);
+  const SymbolicBayesNet bayesNet = *graph.eliminateSequential(ordering);
+  if (analysis.postorder().size() != n) return false;
+  size_t nnz = 0;
+  for (const SymbolicConditional::shared_ptr& conditional : bayesNet) {
+    const size_t j = conditional->firstFrontalKey();
+    const size_t parent = conditional->nrParents() > 0
+        ? *conditional->beginParents() : SymbolicAnalysis::None;
+    if (analysis.columnCounts()[j] != conditional->size()
+        || analysis.parents()[j] != parent)
+      return false;
+    nnz += conditional->size();
+  }
+  return analysis.nnz() == nnz;
+}
+}
+
+/* ************************************************************************* */
+TEST(SymbolicAnalysis, chain) {
+  SymbolicFactorGraph graph;
+  graph.push_factor(0, 1);
+  graph.push_factor(1, 2);
+  graph.push_factor(2, 3);
+  graph.push_factor(3);
+  const SymbolicAnalysis analysis = analyze(4, graph);
+
+  FastVector<size_t> expectedParents, expectedCounts;
+  expectedParents += 1, 2, 3, SymbolicAnalysis::None;
+  expectedCounts += 2, 2, 2, 1;
+  EXPECT(expectedParents == analysis.parents());
+  EXPECT(expectedCounts == analysis.columnCounts());
+  LONGS_EQUAL(7, analysis.nnz());
+}
+
+/* ************************************************************************* */
+TEST(SymbolicAnalysis, forest) {
+  // Two disconnected trees, {0,1,4} and {2,3}, and a variable with no factors
+  SymbolicFactorGraph graph;
+  graph.push_factor(0, 4);
+  graph.push_factor(1, 4);
+  graph.push_factor(2, 3);
+  const SymbolicAnalysis analysis = analyze(6, graph);
+
+  FastVector<size_t> expectedParents, expectedCounts, expectedPostorder;
+  expectedParents += 4, 4, 3, SymbolicAnalysis::None, SymbolicAnalysis::None,
+      SymbolicAnalysis::None;
+  expectedCounts += 2, 2, 2, 1, 1, 1;
+  expectedPostorder += 2, 3, 0, 1, 4, 5;
+  EXPECT(expectedParents == analysis.parents());
+  EXPECT(expectedCounts == analysis.columnCounts());
+  EXPECT(expectedPostorder == analysis.postorder());
+}
+
+/* ************************************************************************* */
+TEST(SymbolicAnalysis, fill) {
+  // Eliminating 0 connects 1 and 2, eliminating 1 then connects 2 and 4
+  SymbolicFactorGraph graph;
+  graph.push_factor(0, 1);
+  graph.push_factor(0, 2);
+  graph.push_factor(1, 4);
+  graph.push_factor(2, 4);
+  graph.push_factor(3, 4);
+  EXPECT(agrees(5, graph));
+}
+
+/* ************************************************************************* */
+TEST(SymbolicAnalysis, random) {
+  // Random factors on up to four variables, with lots of fill
+  boost::mt19937 rng(42);
+  boost::uniform_int<size_t> arity(1, 4);
+  for (size_t trial = 0; trial < 20; ++trial) {
+    const size_t n = 10 + 5 * trial;
+    boost::uniform_int<Key> variable(0, n - 1);
+    SymbolicFactorGraph graph;
+    for (size_t j = 0; j < n; ++j)  // make sure every variable is involved
+      graph.push_factor(j);
+    for (size_t i = 0; i < n; ++i) {
+      KeySet keys;
+      for (size_t k = arity(rng); k > 0; --k) keys.insert(variable(rng));
+      graph.push_back(SymbolicFactor::FromKeysShared(keys));
+    }
+    EXPECT(agrees(n, graph));
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -0,0 +1,221 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file FixedKalmanFilter.h
+ * @brief Linear Kalman filter with fixed-size state, without factor graphs.
+ */
+
+#pragma once
+
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/inference/Key.h>
+
+#include <Eigen/Cholesky>
+#include <Eigen/QR>
+
+#include <cassert>
+#include <iostream>
+#include <string>
+
+namespace gtsam {
+
+/**
+ * Kalman filter with a state dimension \c N known at compile time.
+ *
+ * It implements the same square-root information filter as KalmanFilter with QR
+ * factorization, and gives the same results, but it operates directly on fixed-size
+ * Eigen matrices instead of building and eliminating a small GaussianFactorGraph in
+ * every step.  Hence predict and update do not allocate memory, which matters when
+ * running many small filters.  The control and measurement dimensions are deduced
+ * from the matrices passed to predict and update.
+ *
+ * Like KalmanFilter, this class is functional: init(), predict() and update() create
+ * new states out of old ones.
+ */
+template <int N>
+class FixedKalmanFilter {
+public:
+  typedef Eigen::Matrix<double, N, N> MatrixN;
+  typedef Eigen::Matrix<double, N, 1> VectorN;
+
+  /**
+   * The state is a Gaussian density on x_k in square-root information form,
+   * |R*x_k - d|^2 with R upper-triangular, like the GaussianDensity in KalmanFilter.
+   */
+  struct State {
+    Key k; ///< step index, starts at 0, incremented at each predict
+    MatrixN R; ///< upper-triangular square-root information matrix
+    VectorN d; ///< right-hand side
+
+    /// Return the mean, R\d
+    VectorN mean() const {
+      return R.template triangularView<Eigen::Upper>().solve(d);
+    }
+
+    /// Return the information matrix R'*R
+    MatrixN information() const {
+      return R.transpose() * R;
+    }
+
+    /// Return the covariance matrix inv(R'*R)
+    MatrixN covariance() const {
+      const MatrixN Rinv = R.template triangularView<Eigen::Upper>().solve(MatrixN::Identity());
+      return Rinv * Rinv.transpose();
+    }
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  /**
+   * Create initial state, i.e., prior density at time k=0
+   * In Kalman Filter notation, these are x_{0|0} and P_{0|0}
+   * @param x0 estimate at time 0
+   * @param P0 covariance at time 0, given as a diagonal Gaussian 'model'
+   */
+  State init(const VectorN& x0, const SharedDiagonal& P0) const {
+    const VectorN w = invsigmas(P0);
+    State p;
+    p.k = 0;
+    p.R = w.asDiagonal();
+    p.d = w.cwiseProduct(x0);
+    return p;
+  }
+
+  /// version of init with a full covariance matrix
+  State init(const VectorN& x0, const MatrixN& P0) const {
+    // R'*R = inv(P0)
+    const Eigen::LLT<MatrixN> llt(P0);
+    Eigen::LLT<MatrixN, Eigen::Upper> information(llt.solve(MatrixN::Identity()));
+    State p;
+    p.k = 0;
+    p.R = information.matrixU();
+    p.d = p.R * x0;
+    return p;
+  }
+
+  /// print
+  void print(const std::string& s = "") const {
+    std::cout << "FixedKalmanFilter " << s << ", dim = " << N << std::endl;
+  }
+
+  /** Return step index k, starts at 0, incremented at each predict. */
+  static Key step(const State& p) {
+    return p.k;
+  }
+
+  /**
+   * Predict the state P(x_{t+1}|Z^t), for the motion model F*x_{t} + B*u_{t} + w,
+   * with w zero-mean, Gaussian white noise with diagonal covariance \c modelQ.
+   */
+  template <int C>
+  State predict(const State& p, const MatrixN& F, const Eigen::Matrix<double, N, C>& B,
+      const Eigen::Matrix<double, C, 1>& u, const SharedDiagonal& modelQ) const {
+    // Motion factor |-F*x_{t} + x_{t+1} - B*u|^2, whitened
+    const VectorN w = invsigmas(modelQ);
+    return predict2(p, -(w.asDiagonal() * F), MatrixN(w.asDiagonal()),
+        VectorN(w.cwiseProduct(B * u)));
+  }
+
+  /// Version of predict with full covariance Q
+  template <int C>
+  State predictQ(const State& p, const MatrixN& F, const Eigen::Matrix<double, N, C>& B,
+      const Eigen::Matrix<double, C, 1>& u, const MatrixN& Q) const {
+    // Whiten the motion factor with inv(L), where Q = L*L'
+    const Eigen::LLT<MatrixN> llt(Q);
+    const MatrixN W = llt.matrixL().solve(MatrixN::Identity());
+    return predict2(p, -(W * F), W, VectorN(W * (B * u)));
+  }
+
+  /**
+   * Predict the state P(x_{t+1}|Z^t), for a motion model given as a whitened
+   * factor |A0*x_{t} + A1*x_{t+1} - b|^2.
+   */
+  State predict2(const State& p, const MatrixN& A0, const MatrixN& A1,
+      const VectorN& b) const {
+    // Stack the prior on x_{t} and the motion factor on [x_{t} x_{t+1}]
+    Eigen::Matrix<double, 2 * N, 2 * N + 1> Ab;
+    Ab << p.R, MatrixN::Zero(), p.d,
+          A0, A1, b;
+
+    // Eliminate x_{t}, and keep the marginal on x_{t+1}
+    triangularize(Ab);
+    State result;
+    result.k = p.k + 1;
+    result.R = Ab.template block<N, N>(N, N);
+    result.d = Ab.template block<N, 1>(N, 2 * N);
+    return result;
+  }
+
+  /// Version of predict2 with a diagonal noise model on the motion factor
+  State predict2(const State& p, const MatrixN& A0, const MatrixN& A1,
+      const VectorN& b, const SharedDiagonal& model) const {
+    const VectorN w = invsigmas(model);
+    return predict2(p, w.asDiagonal() * A0, w.asDiagonal() * A1, w.cwiseProduct(b));
+  }
+
+  /**
+   * Update Kalman filter with a measurement z = H*x_{t} + v, where v is zero-mean,
+   * Gaussian white noise with diagonal covariance \c model.
+   */
+  template <int M>
+  State update(const State& p, const Eigen::Matrix<double, M, N>& H,
+      const Eigen::Matrix<double, M, 1>& z, const SharedDiagonal& model) const {
+    const Eigen::Matrix<double, M, 1> w = invsigmas<M>(model);
+    return updateWhitened<M>(p, w.asDiagonal() * H, w.cwiseProduct(z));
+  }
+
+  /// Version of update with full covariance Q
+  template <int M>
+  State updateQ(const State& p, const Eigen::Matrix<double, M, N>& H,
+      const Eigen::Matrix<double, M, 1>& z, const Eigen::Matrix<double, M, M>& Q) const {
+    typedef Eigen::Matrix<double, M, M> MatrixM;
+    const Eigen::LLT<MatrixM> llt(Q);
+    const MatrixM W = llt.matrixL().solve(MatrixM::Identity());
+    return updateWhitened<M>(p, W * H, W * z);
+  }
+
+private:
+
+  /// Update with a whitened measurement factor |H*x_{t} - z|^2
+  template <int M>
+  static State updateWhitened(const State& p, const Eigen::Matrix<double, M, N>& H,
+      const Eigen::Matrix<double, M, 1>& z) {
+    Eigen::Matrix<double, N + M, N + 1> Ab;
+    Ab << p.R, p.d,
+          H, z;
+    triangularize(Ab);
+    State result;
+    result.k = p.k;
+    result.R = Ab.template topLeftCorner<N, N>();
+    result.d = Ab.template block<N, 1>(0, N);
+    return result;
+  }
+
+  /// In-place QR, leaving [R d] with a positive diagonal so that R is unique
+  template <int ROWS, int COLS>
+  static void triangularize(Eigen::Matrix<double, ROWS, COLS>& Ab) {
+    const Eigen::HouseholderQR<Eigen::Matrix<double, ROWS, COLS> > qr(Ab);
+    Ab = qr.matrixQR().template triangularView<Eigen::Upper>();
+    const int n = ROWS < COLS ? ROWS : COLS;
+    for (int i = 0; i < n; ++i)
+      if (Ab(i, i) < 0.0) Ab.row(i) *= -1.0;
+  }
+
+  /// Inverse sigmas of a diagonal model, as a fixed-size vector
+  template <int M = N>
+  static Eigen::Matrix<double, M, 1> invsigmas(const SharedDiagonal& model) {
+    assert(model && model->dim() == M && !model->isConstrained());
+    return model->invsigmas();
+  }
+};
+
+} // \namespace gtsam
@@ -18,6 +18,7 @@
 #include <gtsam/linear/linearExceptions.h>
 #include <gtsam/linear/GaussianConditional.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/cholesky.h>
 
 #include <boost/format.hpp>
 #ifdef __GNUC__
@@ -120,10 +121,10 @@ namespace gtsam {
     const Vector xS = x.vector(KeyVector(beginParents(), endParents()));
 
     // Update right-hand-side
-    const Vector rhs = d() - S() * xS;
+    Vector solution = d() - S() * xS;
 
     // Solve matrix
-    const Vector solution = R().triangularView<Eigen::Upper>().solve(rhs);
+    solveUpperInPlace(R(), solution);
 
     // Check for indeterminant solution
     if (solution.hasNaN()) {
@@ -152,7 +153,8 @@ namespace gtsam {
     xS = rhsR - S() * xS;
 
     // Solve Matrix
-    Vector soln = R().triangularView<Eigen::Upper>().solve(xS);
+    Vector soln = xS;
+    solveUpperInPlace(R(), soln);
 
     // Scale by sigmas
     if (model_)
@@ -172,7 +174,7 @@ namespace gtsam {
   /* ************************************************************************* */
   void GaussianConditional::solveTransposeInPlace(VectorValues& gy) const {
     Vector frontalVec = gy.vector(KeyVector(beginFrontals(), endFrontals()));
-    frontalVec = R().transpose().triangularView<Eigen::Lower>().solve(frontalVec);
+    solveUpperTransposeInPlace(R(), frontalVec);
 
     // Check for indeterminant solution
     if (frontalVec.hasNaN()) throw IndeterminantLinearSystemException(this->keys().front());
@@ -28,7 +28,8 @@ namespace gtsam {
 
   /* ************************************************************************* */
   GaussianJunctionTree::GaussianJunctionTree(
-    const GaussianEliminationTree& eliminationTree) :
-  Base(eliminationTree) {}
+    const GaussianEliminationTree& eliminationTree,
+    const AmalgamationParams& amalgamation) :
+  Base(eliminationTree, amalgamation) {}
 
 }
@@ -46,9 +46,12 @@ namespace gtsam {
     * @param structure The set of factors involving each variable.  If this is not
     * precomputed, you can call the Create(const FactorGraph<DERIVEDFACTOR>&)
     * named constructor instead.
+    * @param amalgamation Controls merging of elimination tree nodes into cliques, see
+    * AmalgamationParams
     * @return The elimination tree
     */
-    GaussianJunctionTree(const GaussianEliminationTree& eliminationTree);
+    GaussianJunctionTree(const GaussianEliminationTree& eliminationTree,
+        const AmalgamationParams& amalgamation = AmalgamationParams());
   };
 
 }
@@ -469,7 +469,8 @@ Vector HessianFactor::gradient(Key key, const VectorValues& x) const {
 }
 
 /* ************************************************************************* */
-boost::shared_ptr<GaussianConditional> HessianFactor::eliminateCholesky(const Ordering& keys) {
+boost::shared_ptr<GaussianConditional> HessianFactor::eliminateCholesky(const Ordering& keys,
+    bool singlePrecision) {
   gttic(HessianFactor_eliminateCholesky);
 
   GaussianConditional::shared_ptr conditional;
@@ -478,7 +479,10 @@ boost::shared_ptr<GaussianConditional> HessianFactor::eliminateCholesky(const Or
     // Do dense elimination
     size_t nFrontals = keys.size();
     assert(nFrontals <= size());
-    info_.choleskyPartial(nFrontals);
+    if (singlePrecision)
+      info_.choleskyPartialSinglePrecision(nFrontals);
+    else
+      info_.choleskyPartial(nFrontals);
 
     // TODO(frank): pre-allocate GaussianConditional and write into it
     const VerticalBlockMatrix Ab = info_.split(nFrontals);
@@ -526,20 +530,26 @@ VectorValues HessianFactor::solve() {
 }
 
 /* ************************************************************************* */
-std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
-EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys) {
-  gttic(EliminateCholesky);
-
-  // Build joint factor
-  HessianFactor::shared_ptr jointFactor;
+// Build the joint factor on all keys involved in the factors to be eliminated
+static HessianFactor::shared_ptr jointHessian(const GaussianFactorGraph& factors,
+                                              const Ordering& keys) {
   try {
     Scatter scatter(factors, keys);
-    jointFactor = boost::make_shared<HessianFactor>(factors, scatter);
+    return boost::make_shared<HessianFactor>(factors, scatter);
   } catch (std::invalid_argument&) {
     throw InvalidDenseElimination(
         "EliminateCholesky was called with a request to eliminate variables that are not\n"
         "involved in the provided factors.");
   }
+}
+
+/* ************************************************************************* */
+std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
+EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys) {
+  gttic(EliminateCholesky);
+
+  // Build joint factor
+  HessianFactor::shared_ptr jointFactor = jointHessian(factors, keys);
 
   // Do dense elimination
   auto conditional = jointFactor->eliminateCholesky(keys);
@@ -548,6 +558,15 @@ EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys) {
   return make_pair(conditional, jointFactor);
 }
 
+/* ************************************************************************* */
+std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
+EliminateCholeskySinglePrecision(const GaussianFactorGraph& factors, const Ordering& keys) {
+  gttic(EliminateCholeskySinglePrecision);
+  HessianFactor::shared_ptr jointFactor = jointHessian(factors, keys);
+  auto conditional = jointFactor->eliminateCholesky(keys, true);
+  return make_pair(conditional, jointFactor);
+}
+
 /* ************************************************************************* */
 std::pair<boost::shared_ptr<GaussianConditional>,
     boost::shared_ptr<GaussianFactor> > EliminatePreferCholesky(
@@ -337,9 +337,11 @@ namespace gtsam {
 
     /**
      *  In-place elimination that returns a conditional on (ordered) keys specified, and leaves
-     *  this factor to be on the remaining keys (separator) only. Does dense partial Cholesky.
+     *  this factor to be on the remaining keys (separator) only. Does dense partial Cholesky,
+     *  in single precision if \c singlePrecision is true.
      */
-    boost::shared_ptr<GaussianConditional> eliminateCholesky(const Ordering& keys);
+    boost::shared_ptr<GaussianConditional> eliminateCholesky(const Ordering& keys,
+        bool singlePrecision = false);
 
       /// Solve the system A'*A delta = A'*b in-place, return delta as VectorValues
     VectorValues solve();
@@ -391,6 +393,15 @@ namespace gtsam {
 GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
   EliminateCholesky(const GaussianFactorGraph& factors, const Ordering& keys);
 
+/**
+*   Same as EliminateCholesky, but the dense partial Cholesky is done in single precision. The
+*   resulting conditionals are only accurate to float precision, and are meant to be used as a
+*   preconditioner for iterative refinement in double, see optimizeMixedPrecision.
+*
+*   \addtogroup LinearSolving */
+GTSAM_EXPORT std::pair<boost::shared_ptr<GaussianConditional>, boost::shared_ptr<HessianFactor> >
+  EliminateCholeskySinglePrecision(const GaussianFactorGraph& factors, const Ordering& keys);
+
 /**
 *   Densely partially eliminate with Cholesky factorization.  JacobianFactors are
 *   left-multiplied with their transpose to form the Hessian using the conversion constructor
@@ -0,0 +1,110 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    IterativeRefinement.cpp
+ * @brief   Mixed-precision multifrontal solve, refined in double precision
+ */
+
+#include <gtsam/linear/IterativeRefinement.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/GaussianConditional.h>
+#include <gtsam/base/timing.h>
+
+#include <algorithm>
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  namespace {
+    // All cliques of the Bayes tree, parents before children
+    FastVector<GaussianBayesTreeClique::shared_ptr> cliquesInPreOrder(
+        const GaussianBayesTree& bayesTree) {
+      FastVector<GaussianBayesTreeClique::shared_ptr> cliques, stack(
+          bayesTree.roots().rbegin(), bayesTree.roots().rend());
+      while (!stack.empty()) {
+        GaussianBayesTreeClique::shared_ptr clique = stack.back();
+        stack.pop_back();
+        cliques.push_back(clique);
+        stack.insert(stack.end(), clique->children.rbegin(), clique->children.rend());
+      }
+      return cliques;
+    }
+
+    // Solve R'R dx = r, where R is the square root information matrix of the Bayes tree
+    VectorValues solveNormalEquations(
+        const FastVector<GaussianBayesTreeClique::shared_ptr>& cliques, VectorValues r) {
+      // Forward substitution with R', children before parents
+      for (size_t i = cliques.size(); i > 0; --i)
+        cliques[i - 1]->conditional()->solveTransposeInPlace(r);
+
+      // Back-substitution with R, parents before children
+      VectorValues dx;
+      for (const GaussianBayesTreeClique::shared_ptr& clique : cliques)
+        dx.insert(clique->conditional()->solveOtherRHS(dx, r));
+      return dx;
+    }
+  }
+
+  /* ************************************************************************* */
+  IterativeRefinementResult refineSolution(const GaussianFactorGraph& graph,
+      const GaussianBayesTree& bayesTree, const VectorValues& initial,
+      const IterativeRefinementParams& params)
+  {
+    gttic(refineSolution);
+    const FastVector<GaussianBayesTreeClique::shared_ptr> cliques = cliquesInPreOrder(bayesTree);
+
+    // A'b, to compute the residuals and to scale them
+    VectorValues Atb = graph.gradientAtZero();
+    Atb *= -1.0;
+    const double AtbNorm = Atb.norm();
+
+    IterativeRefinementResult result;
+    result.solution = initial;
+    while (true) {
+      // Residual of the normal equations, r = A'b - A'A x, in double precision
+      VectorValues r = Atb;
+      graph.multiplyHessianAdd(-1.0, result.solution, r);
+      const double relativeResidual = AtbNorm > 0.0 ? r.norm() / AtbNorm : r.norm();
+      result.relativeResiduals.push_back(relativeResidual);
+
+      if (relativeResidual <= params.relativeTolerance) {
+        result.converged = true;
+        break;
+      }
+      if (result.iterations >= params.maxIterations)
+        break;
+
+      // Correct the solution using the approximate factorization
+      result.solution += solveNormalEquations(cliques, r);
+      ++result.iterations;
+    }
+    return result;
+  }
+
+  /* ************************************************************************* */
+  IterativeRefinementResult optimizeMixedPrecision(const GaussianFactorGraph& graph,
+      const Ordering& ordering, const IterativeRefinementParams& params)
+  {
+    gttic(optimizeMixedPrecision);
+    GaussianBayesTree::shared_ptr bayesTree =
+        graph.eliminateMultifrontal(ordering, EliminateCholeskySinglePrecision);
+    return refineSolution(graph, *bayesTree, bayesTree->optimize(), params);
+  }
+
+  /* ************************************************************************* */
+  IterativeRefinementResult optimizeMixedPrecision(const GaussianFactorGraph& graph,
+      const IterativeRefinementParams& params)
+  {
+    return optimizeMixedPrecision(graph, Ordering::Colamd(graph), params);
+  }
+
+}
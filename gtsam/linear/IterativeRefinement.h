@@ -0,0 +1,78 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    IterativeRefinement.h
+ * @brief   Mixed-precision multifrontal solve, refined in double precision
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Ordering.h>
+
+#include <vector>
+
+namespace gtsam {
+
+  /// Parameters for iterative refinement of a linear solve
+  struct GTSAM_EXPORT IterativeRefinementParams {
+    size_t maxIterations; ///< Maximum number of refinement steps (default: 10)
+    double relativeTolerance; ///< Stop when |A'(b-Ax)| <= relativeTolerance * |A'b| (default: 1e-10)
+
+    IterativeRefinementParams(size_t _maxIterations = 10, double _relativeTolerance = 1e-10) :
+      maxIterations(_maxIterations), relativeTolerance(_relativeTolerance) {}
+  };
+
+  /// Solution and convergence statistics of iterative refinement
+  struct GTSAM_EXPORT IterativeRefinementResult {
+    VectorValues solution; ///< The refined solution
+    size_t iterations; ///< Number of refinement steps taken
+    std::vector<double> relativeResiduals; ///< |A'(b-Ax)| / |A'b| before each step, and at the end
+    bool converged; ///< Whether relativeTolerance was reached
+
+    IterativeRefinementResult() : iterations(0), converged(false) {}
+
+    /// The relative residual of the returned solution
+    double finalResidual() const {
+      return relativeResiduals.empty() ? 0.0 : relativeResiduals.back();
+    }
+  };
+
+  /**
+   * Refine the solution \c initial of the least-squares problem \c graph, using \c bayesTree as
+   * an approximate factorization of its Hessian: each step computes the normal equation residual
+   * r = A'(b-Ax) in double precision against the original graph, and corrects x by solving
+   * R'R dx = r with the Bayes tree.  \c bayesTree can be any factorization of the same system,
+   * e.g., one computed in lower precision, or with an older linearization.
+   */
+  GTSAM_EXPORT IterativeRefinementResult refineSolution(const GaussianFactorGraph& graph,
+      const GaussianBayesTree& bayesTree, const VectorValues& initial,
+      const IterativeRefinementParams& params = IterativeRefinementParams());
+
+  /**
+   * Solve the least-squares problem \c graph by multifrontal elimination with the clique
+   * factorizations done in single precision (see EliminateCholeskySinglePrecision), followed by
+   * iterative refinement in double precision.  For well-conditioned problems this reaches the
+   * accuracy of GaussianFactorGraph::optimize in a few steps, while the dense kernels, which
+   * dominate for large cliques, run in float.  Constrained noise models are not supported.
+   */
+  GTSAM_EXPORT IterativeRefinementResult optimizeMixedPrecision(const GaussianFactorGraph& graph,
+      const Ordering& ordering,
+      const IterativeRefinementParams& params = IterativeRefinementParams());
+
+  /// optimizeMixedPrecision using a COLAMD ordering
+  GTSAM_EXPORT IterativeRefinementResult optimizeMixedPrecision(const GaussianFactorGraph& graph,
+      const IterativeRefinementParams& params = IterativeRefinementParams());
+
+}
@@ -18,6 +18,7 @@
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/GaussianConditional.h>
 #include <gtsam/base/treeTraversal-inst.h>
+#include <gtsam/base/cholesky.h>
 
 #include <boost/optional.hpp>
 #include <boost/shared_ptr.hpp>
@@ -87,10 +88,8 @@ namespace gtsam
             // This is because Eigen (as of 3.3) no longer evaluates S * xS into
             // a temporary, and the operation trashes valus in xS.
             // See: http://eigen.tuxfamily.org/index.php?title=3.3
-            const Vector rhs = c.getb() - c.S() * xS;
-
-            // TODO(gareth): Inline instantiation of Eigen::Solve and check flag
-            const Vector solution = c.R().triangularView<Eigen::Upper>().solve(rhs);
+            Vector solution = c.getb() - c.S() * xS;
+            solveUpperInPlace(c.R(), solution);
 
             // Check for indeterminant solution
             if(solution.hasNaN()) throw IndeterminantLinearSystemException(c.keys().front());
@@ -0,0 +1,122 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testFixedKalmanFilter.cpp
+ * @brief Test fixed-size Kalman filter against the factor graph version
+ */
+
+#include <gtsam/linear/FixedKalmanFilter.h>
+#include <gtsam/linear/KalmanFilter.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/base/Testable.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+typedef FixedKalmanFilter<2> KF2;
+
+/* ************************************************************************* */
+TEST( FixedKalmanFilter, init ) {
+  KF2 kf;
+  const Vector2 x_initial(1.0, 2.0);
+  SharedDiagonal P1 = noiseModel::Isotropic::Sigma(2, 0.1);
+  KF2::State p1 = kf.init(x_initial, P1);
+  EXPECT(assert_equal(Vector(x_initial), Vector(p1.mean())));
+  Matrix2 Sigma = 0.01 * I_2x2;
+  EXPECT(assert_equal(Matrix(Sigma), Matrix(p1.covariance())));
+  EXPECT(assert_equal(Matrix(Sigma.inverse()), Matrix(p1.information())));
+  LONGS_EQUAL(0, (long)KF2::step(p1));
+
+  // With a full covariance
+  Sigma << 0.02, 0.01, 0.01, 0.03;
+  KF2::State p2 = kf.init(x_initial, Sigma);
+  EXPECT(assert_equal(Vector(x_initial), Vector(p2.mean())));
+  EXPECT(assert_equal(Matrix(Sigma), Matrix(p2.covariance())));
+}
+
+/* ************************************************************************* */
+TEST( FixedKalmanFilter, linear1 ) {
+  const Matrix2 F = (Matrix2() << 1.0, 0.1, 0.2, 1.1).finished();
+  const Eigen::Matrix<double, 2, 3> B =
+      (Eigen::Matrix<double, 2, 3>() << 1.0, 0.1, 0.2, 1.1, 1.2, 0.8).finished();
+  const Vector3 u(1.0, 0.0, 2.0);
+  SharedDiagonal modelQ = noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.2));
+  const Matrix2 Q = (Matrix2() << 0.02, 0.005, 0.005, 0.01).finished();
+  const Eigen::Matrix<double, 3, 2> H =
+      (Eigen::Matrix<double, 3, 2>() << 1.0, 0.0, 0.0, 1.0, 0.5, 0.5).finished();
+  const Vector3 z(1.0, 0.5, 0.8);
+  SharedDiagonal modelR = noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.2, 0.3));
+  const Matrix3 R = (Matrix3() << 0.02, 0.0, 0.01, 0.0, 0.03, 0.0, 0.01, 0.0, 0.04).finished();
+
+  // Run both filters side by side
+  KalmanFilter kf(2);
+  KF2 fkf;
+  const Vector2 x0(0.1, -0.2);
+  SharedDiagonal P0 = noiseModel::Isotropic::Sigma(2, 0.5);
+  KalmanFilter::State expected = kf.init(x0, P0);
+  KF2::State actual = fkf.init(x0, P0);
+
+  for (size_t k = 0; k < 3; ++k) {
+    expected = kf.predict(expected, F, B, u, modelQ);
+    actual = fkf.predict(actual, F, B, u, modelQ);
+    EXPECT(assert_equal(expected->mean(), Vector(actual.mean()), 1e-9));
+    EXPECT(assert_equal(expected->information(), Matrix(actual.information()), 1e-7));
+
+    expected = kf.update(expected, H, z, modelR);
+    actual = fkf.update(actual, H, z, modelR);
+    EXPECT(assert_equal(expected->mean(), Vector(actual.mean()), 1e-9));
+    EXPECT(assert_equal(expected->information(), Matrix(actual.information()), 1e-7));
+
+    expected = kf.predictQ(expected, F, B, u, Q);
+    actual = fkf.predictQ(actual, F, B, u, Q);
+    EXPECT(assert_equal(expected->mean(), Vector(actual.mean()), 1e-9));
+    EXPECT(assert_equal(expected->covariance(), Matrix(actual.covariance()), 1e-9));
+
+    expected = kf.updateQ(expected, H, z, R);
+    actual = fkf.updateQ(actual, H, z, R);
+    EXPECT(assert_equal(expected->mean(), Vector(actual.mean()), 1e-9));
+    EXPECT(assert_equal(expected->covariance(), Matrix(actual.covariance()), 1e-9));
+  }
+  LONGS_EQUAL((long)KalmanFilter::step(expected), (long)KF2::step(actual));
+
+  // R is kept upper-triangular with a positive diagonal
+  EXPECT(actual.R(1, 0) == 0.0);
+  EXPECT(actual.R(0, 0) > 0.0 && actual.R(1, 1) > 0.0);
+}
+
+/* ************************************************************************* */
+TEST( FixedKalmanFilter, predict2 ) {
+  // Same check as KalmanFilter predict: predictQ and predict2 agree
+  const Matrix2 F = (Matrix2() << 1.0, 0.1, 0.2, 1.1).finished();
+  const Eigen::Matrix<double, 2, 3> B =
+      (Eigen::Matrix<double, 2, 3>() << 1.0, 0.1, 0.2, 1.1, 1.2, 0.8).finished();
+  const Vector3 u(1.0, 0.0, 2.0);
+  const Matrix2 R = (Matrix2() << 1.0, 0.5, 0.0, 3.0).finished();
+  const Matrix2 Q = (R.transpose() * R).inverse();
+
+  KF2 kf;
+  KF2::State p0 = kf.init(Vector2(0.0, 0.0), noiseModel::Isotropic::Sigma(2, 1));
+  KF2::State pa = kf.predictQ(p0, F, B, u, Q);
+  KF2::State pb = kf.predict2(p0, -R * F, R, R * B * u,
+      noiseModel::Isotropic::Sigma(2, 1.0));
+  EXPECT(assert_equal(Vector(pa.mean()), Vector(pb.mean())));
+  EXPECT(assert_equal(Matrix(pa.covariance()), Matrix(pb.covariance())));
+  LONGS_EQUAL(1, (long)KF2::step(pb));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,113 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testIterativeRefinement.cpp
+ * @brief   Unit tests for the mixed-precision solve with iterative refinement
+ */
+
+#include <gtsam/linear/IterativeRefinement.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/base/Testable.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <random>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+  // A chain of 3-dimensional variables with odometry-like factors and a few loop closures
+  GaussianFactorGraph createGraph(size_t n) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    const auto random = [&](int rows, int cols) {
+      Matrix A(rows, cols);
+      for (int i = 0; i < A.size(); ++i) A(i) = uniform(rng);
+      return A;
+    };
+    const SharedDiagonal model = noiseModel::Isotropic::Sigma(3, 0.1);
+
+    GaussianFactorGraph graph;
+    graph += JacobianFactor(0, 10 * I_3x3, random(3, 1), model);
+    for (size_t j = 1; j < n; ++j) {
+      const Matrix3 A = I_3x3 + 0.2 * random(3, 3);
+      graph += JacobianFactor(j - 1, -A, j, I_3x3, random(3, 1), model);
+      if (j >= 5 && j % 5 == 0)
+        graph += JacobianFactor(j - 5, -I_3x3, j, A, random(3, 1), model);
+    }
+    return graph;
+  }
+}
+
+/* ************************************************************************* */
+TEST(IterativeRefinement, optimizeMixedPrecision) {
+  const GaussianFactorGraph graph = createGraph(50);
+  const Ordering ordering = Ordering::Colamd(graph);
+  const VectorValues expected = graph.optimize(ordering);
+
+  const IterativeRefinementResult actual = optimizeMixedPrecision(graph, ordering);
+  EXPECT(actual.converged);
+  EXPECT(actual.iterations > 0);
+  EXPECT(actual.iterations <= IterativeRefinementParams().maxIterations);
+  EXPECT_LONGS_EQUAL(actual.iterations + 1, actual.relativeResiduals.size());
+  EXPECT(actual.finalResidual() <= 1e-10);
+  EXPECT(actual.relativeResiduals.front() > actual.finalResidual());
+  EXPECT(assert_equal(expected, actual.solution, 1e-8));
+
+  // Same result with the default ordering
+  EXPECT(assert_equal(expected, optimizeMixedPrecision(graph).solution, 1e-8));
+}
+
+/* ************************************************************************* */
+TEST(IterativeRefinement, singlePrecisionElimination) {
+  // The float factorization alone is only accurate to about float precision
+  const GaussianFactorGraph graph = createGraph(20);
+  const Ordering ordering = Ordering::Colamd(graph);
+  const VectorValues expected = graph.optimize(ordering);
+  const VectorValues actual =
+      graph.eliminateMultifrontal(ordering, EliminateCholeskySinglePrecision)->optimize();
+  EXPECT(assert_equal(expected, actual, 1e-3));
+}
+
+/* ************************************************************************* */
+TEST(IterativeRefinement, refineSolution) {
+  // Refining with the exact factorization converges in one step
+  const GaussianFactorGraph graph = createGraph(20);
+  const GaussianBayesTree::shared_ptr bayesTree = graph.eliminateMultifrontal();
+  const VectorValues expected = bayesTree->optimize();
+
+  const IterativeRefinementResult actual = refineSolution(graph, *bayesTree,
+      VectorValues::Zero(expected), IterativeRefinementParams(5, 1e-9));
+  EXPECT(actual.converged);
+  EXPECT_LONGS_EQUAL(1, actual.iterations);
+  EXPECT_DOUBLES_EQUAL(1.0, actual.relativeResiduals.front(), 1e-9);
+  EXPECT(assert_equal(expected, actual.solution, 1e-8));
+
+  // No steps are taken if the initial estimate is already good enough
+  const IterativeRefinementResult none = refineSolution(graph, *bayesTree, expected,
+      IterativeRefinementParams(5, 1e-9));
+  EXPECT(none.converged);
+  EXPECT_LONGS_EQUAL(0, none.iterations);
+
+  // Stops after maxIterations when the tolerance is unreachable
+  const IterativeRefinementResult capped = refineSolution(graph, *bayesTree,
+      VectorValues::Zero(expected), IterativeRefinementParams(2, 0.0));
+  EXPECT(!capped.converged);
+  EXPECT_LONGS_EQUAL(2, capped.iterations);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
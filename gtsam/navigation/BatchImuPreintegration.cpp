@@ -0,0 +1,290 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file   BatchImuPreintegration.cpp
+ *  @brief  Preintegrate one IMU stream against many bias hypotheses at once
+ **/
+
+#include <gtsam/navigation/BatchImuPreintegration.h>
+
+#include <limits>
+#include <stdexcept>
+
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+using namespace internal;
+
+typedef LaneMatrix<9, 3> Lanes93;
+typedef LaneMatrix<9, 9> Lanes99;
+
+//------------------------------------------------------------------------------
+// Lane-wise version of TangentPreintegration::update followed by the
+// covariance propagation in PreintegratedImuMeasurements::integrateMeasurement.
+// The branch on small angles in so3::DexpFunctor becomes a per-lane select.
+void integrateBlock(BatchImuPreintegration::Block& block,
+    const Vector3& measuredAcc, const Vector3& measuredOmega, double dt,
+    const Matrix3& aCovOverDt, const Matrix3& wCovOverDt,
+    const Matrix3& iCovTimesDt) {
+  const double dt22 = 0.5 * dt * dt;
+
+  // Correct for bias in the sensor frame
+  Lanes3 theta, acc, omega;
+  for (int i = 0; i < 3; i++) {
+    theta(i, 0) = block.preintegrated[i];
+    acc(i, 0) = measuredAcc(i) - block.biasAcc[i];
+    omega(i, 0) = measuredOmega(i) - block.biasOmega[i];
+  }
+
+  // so3::DexpFunctor at theta
+  const Lanes theta2 = theta(0, 0).square() + theta(1, 0).square()
+      + theta(2, 0).square();
+  const LaneMask nearZero =
+      theta2 <= std::numeric_limits<double>::epsilon();
+  const Lanes safeTheta2 = nearZero.select(Lanes::Ones(), theta2);
+  const Lanes safeTheta = safeTheta2.sqrt();
+  const Lanes sinTheta = safeTheta.sin();
+  const Lanes s2 = (0.5 * safeTheta).sin();
+  const Lanes oneMinusCos = 2.0 * s2 * s2;
+  const Lanes a = oneMinusCos / safeTheta;
+  const Lanes b = 1.0 - sinTheta / safeTheta;
+
+  const Lanes33 W = skew(theta);
+  Lanes33 K;
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) K(i, j) = W(i, j) / safeTheta;
+  const Lanes33 KK = K * K;
+
+  Lanes33 R, dexp;
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) {
+      const double I = (i == j) ? 1.0 : 0.0;
+      R(i, j) = nearZero.select(I + W(i, j),
+                                I + sinTheta * K(i, j) + oneMinusCos * KK(i, j));
+      dexp(i, j) = nearZero.select(I - 0.5 * W(i, j),
+                                   I - a * K(i, j) + b * KK(i, j));
+    }
+  const Lanes33 invDexp = inverse(dexp);
+
+  // Angular velocity mapped back to tangent space, and its derivative
+  const Lanes3 wTangent = invDexp * omega;
+  Lanes33 D_dexpv_theta;
+  {
+    const Lanes3 Kv = K * wTangent;
+    const Lanes Da = (sinTheta - 2.0 * a) / safeTheta2;
+    const Lanes Db = (oneMinusCos - 3.0 * b) / safeTheta2;
+    const Lanes3 KKv = K * Kv;
+    Lanes3 DKv, KvbOverTheta, vOverTheta;
+    for (int i = 0; i < 3; i++) {
+      DKv(i, 0) = Db * KKv(i, 0) - Da * Kv(i, 0);  // (Db * K - Da * I) * Kv
+      KvbOverTheta(i, 0) = Kv(i, 0) * b / safeTheta;
+      vOverTheta(i, 0) = wTangent(i, 0) / safeTheta;
+    }
+    Lanes33 aIbK;
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++) {
+        aIbK(i, j) = -b * K(i, j);
+        if (i == j) aIbK(i, j) += a;
+      }
+    const Lanes33 S1 = skew(KvbOverTheta);
+    const Lanes33 S2 = aIbK * skew(vOverTheta);
+    const Lanes33 S0 = skew(wTangent);
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++)
+        D_dexpv_theta(i, j) = nearZero.select(0.5 * S0(i, j),
+            DKv(i, 0) * theta(j, 0) - S1(i, j) + S2(i, j));
+  }
+  // NOTE: the derivative of wTangent w.r.t. theta is minus this product
+  const Lanes33 invDexp_D_dexpv_theta = invDexp * D_dexpv_theta;
+
+  // Exact derivative of R*a with respect to theta
+  Lanes3 minusAcc;
+  for (int i = 0; i < 3; i++) minusAcc(i, 0) = -acc(i, 0);
+  const Lanes33 aNav_H_theta = (R * skew(minusAcc)) * dexp;
+  const Lanes3 aNav = R * acc;
+
+  // Mean propagation
+  for (int i = 0; i < 3; i++) {
+    const Lanes velocity = block.preintegrated[6 + i];
+    block.preintegrated[i] += wTangent(i, 0) * dt;
+    block.preintegrated[3 + i] += velocity * dt + aNav(i, 0) * dt22;
+    block.preintegrated[6 + i] += aNav(i, 0) * dt;
+  }
+
+  // Jacobians A, B, C as in TangentPreintegration::UpdatePreintegrated
+  Lanes99 A;
+  Lanes93 B, C;
+  A.setIdentity();
+  B.setZero();
+  C.setZero();
+  for (int i = 0; i < 3; i++) {
+    A(3 + i, 6 + i).setConstant(dt);
+    for (int j = 0; j < 3; j++) {
+      A(i, j) -= invDexp_D_dexpv_theta(i, j) * dt;
+      A(3 + i, j) = aNav_H_theta(i, j) * dt22;
+      A(6 + i, j) = aNav_H_theta(i, j) * dt;
+      B(3 + i, j) = R(i, j) * dt22;
+      B(6 + i, j) = R(i, j) * dt;
+      C(i, j) = invDexp(i, j) * dt;
+    }
+  }
+
+  // Bias Jacobians
+  Lanes93 H_biasAcc, H_biasOmega;
+  Lanes99 P;
+  for (int i = 0; i < 9; i++) {
+    for (int j = 0; j < 3; j++) {
+      H_biasAcc(i, j) = block.H_biasAcc[i][j];
+      H_biasOmega(i, j) = block.H_biasOmega[i][j];
+    }
+    for (int j = 0; j < 9; j++) P(i, j) = block.preintMeasCov[i][j];
+  }
+  const Lanes93 AH_biasAcc = A * H_biasAcc;
+  const Lanes93 AH_biasOmega = A * H_biasOmega;
+
+  // First order covariance propagation
+  const Lanes99 APAt = multiplyTranspose(A * P, A);
+  const Lanes99 BQBt = sandwich(B, aCovOverDt);
+  const Lanes99 CQCt = sandwich(C, wCovOverDt);
+
+  for (int i = 0; i < 9; i++) {
+    for (int j = 0; j < 3; j++) {
+      block.H_biasAcc[i][j] = AH_biasAcc(i, j) - B(i, j);
+      block.H_biasOmega[i][j] = AH_biasOmega(i, j) - C(i, j);
+    }
+    for (int j = 0; j < 9; j++)
+      block.preintMeasCov[i][j] = APAt(i, j) + BQBt(i, j) + CQCt(i, j);
+  }
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      block.preintMeasCov[3 + i][3 + j] += iCovTimesDt(i, j);
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+BatchImuPreintegration::BatchImuPreintegration(
+    const boost::shared_ptr<Params>& p,
+    const std::vector<imuBias::ConstantBias>& biasHats) :
+    p_(p), biasHats_(biasHats), deltaTij_(0.0) {
+  if (p_->body_P_sensor) {
+    throw std::domain_error(
+        "BatchImuPreintegration: cannot integrate with sensor pose yet");
+  }
+  if (biasHats_.empty()) {
+    throw std::invalid_argument(
+        "BatchImuPreintegration: needs at least one bias hypothesis");
+  }
+  resetIntegration();
+}
+
+//------------------------------------------------------------------------------
+void BatchImuPreintegration::resetIntegration() {
+  deltaTij_ = 0.0;
+  const size_t n = biasHats_.size();
+  blocks_.resize((n + kLanes - 1) / kLanes);
+  for (size_t b = 0; b < blocks_.size(); b++) {
+    Block& block = blocks_[b];
+    for (size_t lane = 0; lane < kLanes; lane++) {
+      // Unused lanes of the last block replicate the last hypothesis
+      const imuBias::ConstantBias& bias =
+          biasHats_[std::min(b * kLanes + lane, n - 1)];
+      for (int i = 0; i < 3; i++) {
+        block.biasAcc[i](lane) = bias.accelerometer()(i);
+        block.biasOmega[i](lane) = bias.gyroscope()(i);
+      }
+    }
+    for (int i = 0; i < 9; i++) {
+      block.preintegrated[i].setZero();
+      for (int j = 0; j < 3; j++) {
+        block.H_biasAcc[i][j].setZero();
+        block.H_biasOmega[i][j].setZero();
+      }
+      for (int j = 0; j < 9; j++) block.preintMeasCov[i][j].setZero();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void BatchImuPreintegration::integrateMeasurement(const Vector3& measuredAcc,
+    const Vector3& measuredOmega, double dt) {
+  if (dt <= 0) {
+    throw std::runtime_error(
+        "BatchImuPreintegration::integrateMeasurement: dt <=0");
+  }
+
+  // (1/dt) allows to pass from continuous time noise to discrete time noise
+  const Matrix3 aCovOverDt = p_->accelerometerCovariance / dt;
+  const Matrix3 wCovOverDt = p_->gyroscopeCovariance / dt;
+  const Matrix3 iCovTimesDt = p_->integrationCovariance * dt;
+
+  deltaTij_ += dt;
+  for (Block& block : blocks_)
+    integrateBlock(block, measuredAcc, measuredOmega, dt, aCovOverDt,
+                   wCovOverDt, iCovTimesDt);
+}
+
+//------------------------------------------------------------------------------
+void BatchImuPreintegration::integrateMeasurements(const Matrix& measuredAccs,
+    const Matrix& measuredOmegas, const Matrix& dts) {
+  assert(
+      measuredAccs.rows() == 3 && measuredOmegas.rows() == 3 && dts.rows() == 1);
+  assert(measuredAccs.cols() == dts.cols());
+  assert(measuredOmegas.cols() == dts.cols());
+  size_t n = static_cast<size_t>(dts.cols());
+  for (size_t j = 0; j < n; j++) {
+    integrateMeasurement(measuredAccs.col(j), measuredOmegas.col(j), dts(0, j));
+  }
+}
+
+//------------------------------------------------------------------------------
+PreintegratedImuMeasurements BatchImuPreintegration::at(size_t i) const {
+  const imuBias::ConstantBias& biasHat = biasHats_.at(i);
+  const Block& block = blocks_[i / kLanes];
+  const size_t lane = i % kLanes;
+
+  Vector9 preintegrated;
+  Matrix93 H_biasAcc, H_biasOmega;
+  Matrix9 preintMeasCov;
+  for (int r = 0; r < 9; r++) {
+    preintegrated(r) = block.preintegrated[r](lane);
+    for (int c = 0; c < 3; c++) {
+      H_biasAcc(r, c) = block.H_biasAcc[r][c](lane);
+      H_biasOmega(r, c) = block.H_biasOmega[r][c](lane);
+    }
+    for (int c = 0; c < 9; c++)
+      preintMeasCov(r, c) = block.preintMeasCov[r][c](lane);
+  }
+
+  const TangentPreintegration base(p_, biasHat, deltaTij_, preintegrated,
+                                   H_biasAcc, H_biasOmega);
+  return PreintegratedImuMeasurements(base, preintMeasCov);
+}
+
+//------------------------------------------------------------------------------
+std::vector<PreintegratedImuMeasurements> BatchImuPreintegration::all() const {
+  std::vector<PreintegratedImuMeasurements> result;
+  result.reserve(size());
+  for (size_t i = 0; i < size(); i++) result.push_back(at(i));
+  return result;
+}
+
+//------------------------------------------------------------------------------
+
+} // namespace gtsam
+
+#endif // GTSAM_TANGENT_PREINTEGRATION
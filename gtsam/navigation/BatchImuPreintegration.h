@@ -0,0 +1,134 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file   BatchImuPreintegration.h
+ *  @brief  Preintegrate one IMU stream against many bias hypotheses at once
+ **/
+
+#pragma once
+
+#include <gtsam/navigation/ImuFactor.h>
+#include <gtsam/base/LaneMatrix.h>
+
+#include <vector>
+
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+
+namespace gtsam {
+
+/**
+ * BatchImuPreintegration integrates a single stream of IMU measurements under
+ * N different bias estimates simultaneously, as needed by particle-style
+ * filters that carry many hypotheses. The result for each hypothesis is
+ * identical to what a PreintegratedImuMeasurements object constructed with
+ * that bias would produce.
+ *
+ * Internally, the hypotheses are stored in structure-of-arrays blocks of
+ * kLanes hypotheses, i.e., every scalar of the preintegrated vector, of its
+ * bias Jacobians and of its covariance is stored as a small contiguous array
+ * across hypotheses. The tangent-space update of TangentPreintegration is then
+ * evaluated lane-wise, so the compiler can vectorize across hypotheses.
+ *
+ * Only available with GTSAM_TANGENT_PREINTEGRATION, and sensor poses
+ * (body_P_sensor) are not supported.
+ *
+ * @addtogroup SLAM
+ */
+class GTSAM_EXPORT BatchImuPreintegration {
+ public:
+  typedef PreintegrationParams Params;
+
+  /// Number of hypotheses processed together in one SIMD block
+  enum { kLanes = internal::kLaneWidth };
+
+  /// One scalar quantity across the kLanes hypotheses of a block
+  typedef internal::Lanes Lanes;
+
+  /// Structure-of-arrays storage for kLanes hypotheses
+  struct Block {
+    Lanes biasAcc[3];           ///< accelerometer bias estimates
+    Lanes biasOmega[3];         ///< gyroscope bias estimates
+    Lanes preintegrated[9];     ///< theta, position, velocity
+    Lanes H_biasAcc[9][3];      ///< Jacobian of preintegrated w.r.t. acceleration bias
+    Lanes H_biasOmega[9][3];    ///< Jacobian of preintegrated w.r.t. angular rate bias
+    Lanes preintMeasCov[9][9];  ///< covariance of preintegrated
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+ private:
+  boost::shared_ptr<Params> p_;
+  std::vector<imuBias::ConstantBias> biasHats_;
+  double deltaTij_;
+  std::vector<Block, Eigen::aligned_allocator<Block> > blocks_;
+
+ public:
+  /// @name Constructors/destructors
+  /// @{
+
+  /**
+   *  Constructor, initializes one hypothesis per bias estimate
+   *  @param p        Parameters, shared by all hypotheses
+   *  @param biasHats Bias estimates, one for each hypothesis
+   */
+  BatchImuPreintegration(const boost::shared_ptr<Params>& p,
+      const std::vector<imuBias::ConstantBias>& biasHats);
+
+  /// @}
+
+  /// @name Basic utilities
+  /// @{
+
+  /// Re-initialize all hypotheses
+  void resetIntegration();
+
+  /// Number of hypotheses
+  size_t size() const { return biasHats_.size(); }
+
+  /// Parameters shared by all hypotheses
+  const boost::shared_ptr<Params>& params() const { return p_; }
+
+  /// Time interval covered by the measurements so far
+  double deltaTij() const { return deltaTij_; }
+
+  /// Bias estimate of hypothesis i
+  const imuBias::ConstantBias& biasHat(size_t i) const { return biasHats_.at(i); }
+
+  /// @}
+
+  /// @name Main functionality
+  /// @{
+
+  /**
+   * Add a single IMU measurement to all hypotheses.
+   * @param measuredAcc Measured acceleration (in body frame, as given by the sensor)
+   * @param measuredOmega Measured angular velocity (as given by the sensor)
+   * @param dt Time interval between this and the last IMU measurement
+   */
+  void integrateMeasurement(const Vector3& measuredAcc,
+      const Vector3& measuredOmega, double dt);
+
+  /// Add multiple measurements, in matrix columns
+  void integrateMeasurements(const Matrix& measuredAccs,
+      const Matrix& measuredOmegas, const Matrix& dts);
+
+  /// Preintegrated measurements of hypothesis i, as consumed by ImuFactor
+  PreintegratedImuMeasurements at(size_t i) const;
+
+  /// Preintegrated measurements of all hypotheses
+  std::vector<PreintegratedImuMeasurements> all() const;
+
+  /// @}
+};
+
+} // namespace gtsam
+
+#endif // GTSAM_TANGENT_PREINTEGRATION
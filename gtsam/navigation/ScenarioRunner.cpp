@@ -17,10 +17,17 @@
 
 #include <gtsam/navigation/ScenarioRunner.h>
 #include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
 
 #include <boost/assign.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
 #include <cmath>
 
+#ifdef GTSAM_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 using namespace boost::assign;
 
@@ -29,6 +36,125 @@ namespace gtsam {
 static double intNoiseVar = 0.0000001;
 static const Matrix3 kIntegrationErrorCovariance = intNoiseVar * I_3x3;
 
+namespace {
+
+// Random stream of Monte Carlo sample i, independent of the order in which
+// the samples are evaluated. The seed is scrambled with splitmix64, so that
+// the streams of consecutive samples are uncorrelated.
+class SampleStream {
+  boost::random::mt19937_64 generator_;
+  boost::random::normal_distribution<double> normal_;
+
+  static uint64_t mix(uint64_t z) {
+    z += 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+ public:
+  SampleStream(uint64_t seed, size_t i) : generator_(mix(seed ^ mix(i))) {}
+
+  // Draw a zero-mean Gaussian with the given standard deviations
+  Vector3 sample(const Vector3& sigmas) {
+    Vector3 v;
+    for (int j = 0; j < 3; j++) v(j) = sigmas(j) * normal_(generator_);
+    return v;
+  }
+};
+
+// Seed shared by all Monte Carlo estimators
+static const uint64_t kMonteCarloSeed = 29284;
+
+// Ground truth IMU measurements, evaluated once and shared by all samples
+struct TrueMeasurements {
+  vector<Vector3> omegas, accs;
+};
+
+// Computes prediction errors for a range of samples
+class _SampleErrors {
+  const ScenarioRunner& runner_;
+  const TrueMeasurements& truth_;
+  const PreintegratedImuMeasurements& pim0_;
+  const Vector3 &gyroSigmas_, &accSigmas_, &gyroBias_, &accBias_;
+  const NavState& prediction_;
+  size_t firstSample_;
+  Matrix& errors_;
+
+ public:
+  _SampleErrors(const ScenarioRunner& runner, const TrueMeasurements& truth,
+                const PreintegratedImuMeasurements& pim0,
+                const Vector3& gyroSigmas, const Vector3& accSigmas,
+                const Vector3& gyroBias, const Vector3& accBias,
+                const NavState& prediction, size_t firstSample, Matrix& errors)
+      : runner_(runner), truth_(truth), pim0_(pim0), gyroSigmas_(gyroSigmas),
+        accSigmas_(accSigmas), gyroBias_(gyroBias), accBias_(accBias),
+        prediction_(prediction), firstSample_(firstSample), errors_(errors) {}
+
+  void operator()(size_t begin, size_t end) const {
+    const double dt = runner_.imuSampleTime();
+    for (size_t i = begin; i != end; ++i) {
+      SampleStream stream(kMonteCarloSeed, firstSample_ + i);
+      PreintegratedImuMeasurements pim = pim0_;
+      for (size_t k = 0; k < truth_.omegas.size(); k++) {
+        const Vector3 measuredOmega =
+            truth_.omegas[k] + gyroBias_ + stream.sample(gyroSigmas_);
+        const Vector3 measuredAcc =
+            truth_.accs[k] + accBias_ + stream.sample(accSigmas_);
+        pim.integrateMeasurement(measuredAcc, measuredOmega, dt);
+      }
+      errors_.col(i) = runner_.predict(pim).localCoordinates(prediction_);
+    }
+  }
+
+#ifdef GTSAM_USE_TBB
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    (*this)(blocked_range.begin(), blocked_range.end());
+  }
+#endif
+};
+
+// Computes noise samples for a range of samples
+class _SampleNoise {
+  const Vector3 &gyroSigmas_, &accSigmas_;
+  Matrix& samples_;
+
+ public:
+  _SampleNoise(const Vector3& gyroSigmas, const Vector3& accSigmas,
+               Matrix& samples)
+      : gyroSigmas_(gyroSigmas), accSigmas_(accSigmas), samples_(samples) {}
+
+  void operator()(size_t begin, size_t end) const {
+    for (size_t i = begin; i != end; ++i) {
+      SampleStream stream(kMonteCarloSeed, i);
+      samples_.col(i) << stream.sample(accSigmas_), stream.sample(gyroSigmas_);
+    }
+  }
+
+#ifdef GTSAM_USE_TBB
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    (*this)(blocked_range.begin(), blocked_range.end());
+  }
+#endif
+};
+
+// Unbiased sample covariance of the columns of samples
+template <int D>
+Eigen::Matrix<double, D, D> sampleCovariance(const Matrix& samples) {
+  typedef Eigen::Matrix<double, D, 1> VectorD;
+  const size_t N = samples.cols();
+  const VectorD sampleMean = samples.rowwise().sum() / N;
+  Eigen::Matrix<double, D, D> Q;
+  Q.setZero();
+  for (size_t i = 0; i < N; i++) {
+    VectorD xi = samples.col(i) - sampleMean;
+    Q += xi * xi.transpose();
+  }
+  return Q / (N - 1);
+}
+
+}  // namespace
+
 PreintegratedImuMeasurements ScenarioRunner::integrate(
     double T, const Bias& estimatedBias, bool corrupted) const {
   gttic_(integrate);
@@ -54,55 +180,62 @@ NavState ScenarioRunner::predict(const PreintegratedImuMeasurements& pim,
   return pim.predict(state_i, estimatedBias);
 }
 
-Matrix9 ScenarioRunner::estimateCovariance(double T, size_t N,
-                                           const Bias& estimatedBias) const {
-  gttic_(estimateCovariance);
+Matrix ScenarioRunner::sampleErrors(double T, size_t N,
+                                    const Bias& estimatedBias,
+                                    size_t firstSample) const {
+  gttic_(sampleErrors);
 
   // Get predict prediction from ground truth measurements
   NavState prediction = predict(integrate(T));
 
-  // Sample !
-  Matrix samples(9, N);
-  Vector9 sum = Vector9::Zero();
-  for (size_t i = 0; i < N; i++) {
-    auto pim = integrate(T, estimatedBias, true);
-    NavState sampled = predict(pim);
-    Vector9 xi = sampled.localCoordinates(prediction);
-    samples.col(i) = xi;
-    sum += xi;
+  // The scenario is evaluated only once, all samples just add noise
+  TrueMeasurements truth;
+  const double dt = imuSampleTime();
+  const size_t nrSteps = T / dt;
+  double t = 0;
+  for (size_t k = 0; k < nrSteps; k++, t += dt) {
+    truth.omegas.push_back(actualAngularVelocity(t));
+    truth.accs.push_back(actualSpecificForce(t));
   }
 
-  // Compute MC covariance
-  Vector9 sampleMean = sum / N;
-  Matrix9 Q;
-  Q.setZero();
-  for (size_t i = 0; i < N; i++) {
-    Vector9 xi = samples.col(i) - sampleMean;
-    Q += xi * xi.transpose();
-  }
+  // Sample !
+  const Vector3 gyroSigmas = gyroSampler_.sigmas() / sqrt_dt_;
+  const Vector3 accSigmas = accSampler_.sigmas() / sqrt_dt_;
+  const PreintegratedImuMeasurements pim0(p_, estimatedBias);
+  Matrix errors(9, N);
+  _SampleErrors sample(*this, truth, pim0, gyroSigmas, accSigmas,
+                       estimatedBias_.gyroscope(),
+                       estimatedBias_.accelerometer(), prediction,
+                       firstSample, errors);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, N), sample);
+#else
+  sample(0, N);
+#endif
+  return errors;
+}
 
-  return Q / (N - 1);
+Matrix9 ScenarioRunner::estimateCovariance(double T, size_t N,
+                                           const Bias& estimatedBias) const {
+  gttic_(estimateCovariance);
+
+  // Compute MC covariance
+  return sampleCovariance<9>(sampleErrors(T, N, estimatedBias));
 }
 
 Matrix6 ScenarioRunner::estimateNoiseCovariance(size_t N) const {
+  const Vector3 gyroSigmas = gyroSampler_.sigmas() / sqrt_dt_;
+  const Vector3 accSigmas = accSampler_.sigmas() / sqrt_dt_;
   Matrix samples(6, N);
-  Vector6 sum = Vector6::Zero();
-  for (size_t i = 0; i < N; i++) {
-    samples.col(i) << accSampler_.sample() / sqrt_dt_,
-        gyroSampler_.sample() / sqrt_dt_;
-    sum += samples.col(i);
-  }
+  _SampleNoise sample(gyroSigmas, accSigmas, samples);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, N), sample);
+#else
+  sample(0, N);
+#endif
 
   // Compute MC covariance
-  Vector6 sampleMean = sum / N;
-  Matrix6 Q;
-  Q.setZero();
-  for (size_t i = 0; i < N; i++) {
-    Vector6 xi = samples.col(i) - sampleMean;
-    Q += xi * xi.transpose();
-  }
-
-  return Q / (N - 1);
+  return sampleCovariance<6>(samples);
 }
 
 }  // namespace gtsam
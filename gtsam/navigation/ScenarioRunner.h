@@ -98,6 +98,17 @@ class GTSAM_EXPORT ScenarioRunner {
   NavState predict(const PreintegratedImuMeasurements& pim,
                    const Bias& estimatedBias = Bias()) const;
 
+  /**
+   * Sample N noisy trajectories of T seconds, and return the 9*N matrix of
+   * their prediction errors, i.e., column i is the local coordinates of the
+   * ground truth prediction w.r.t. sample firstSample + i.
+   * Each sample draws from its own random stream, seeded by its index, so
+   * the result does not depend on the number of threads, and runs can be
+   * split over several calls with different firstSample.
+   */
+  Matrix sampleErrors(double T, size_t N, const Bias& estimatedBias = Bias(),
+                      size_t firstSample = 0) const;
+
   /// Compute a Monte Carlo estimate of the predict covariance using N samples
   Matrix9 estimateCovariance(double T, size_t N = 1000,
                              const Bias& estimatedBias = Bias()) const;
@@ -30,6 +30,15 @@ TangentPreintegration::TangentPreintegration(const boost::shared_ptr<Params>& p,
   resetIntegration();
 }
 
+//------------------------------------------------------------------------------
+TangentPreintegration::TangentPreintegration(const boost::shared_ptr<Params>& p,
+    const Bias& biasHat, double deltaTij, const Vector9& preintegrated,
+    const Matrix93& H_biasAcc, const Matrix93& H_biasOmega) :
+    PreintegrationBase(p, biasHat), preintegrated_(preintegrated),
+    preintegrated_H_biasAcc_(H_biasAcc), preintegrated_H_biasOmega_(H_biasOmega) {
+  deltaTij_ = deltaTij;
+}
+
 //------------------------------------------------------------------------------
 void TangentPreintegration::resetIntegration() {
   deltaTij_ = 0.0;
@@ -53,6 +53,20 @@ public:
   TangentPreintegration(const boost::shared_ptr<Params>& p,
       const imuBias::ConstantBias& biasHat = imuBias::ConstantBias());
 
+  /**
+   *  Construct directly from members, e.g., from a batch integrator
+   *  @param p                 Parameters, typically fixed in a single application
+   *  @param biasHat           Bias estimate used during integration
+   *  @param deltaTij          Time interval covered by the measurements
+   *  @param preintegrated     Preintegrated 9D vector on tangent space
+   *  @param H_biasAcc         Jacobian of preintegrated w.r.t. acceleration bias
+   *  @param H_biasOmega       Jacobian of preintegrated w.r.t. angular rate bias
+   */
+  TangentPreintegration(const boost::shared_ptr<Params>& p,
+      const imuBias::ConstantBias& biasHat, double deltaTij,
+      const Vector9& preintegrated, const Matrix93& H_biasAcc,
+      const Matrix93& H_biasOmega);
+
   /// Virtual destructor
   virtual ~TangentPreintegration() {
   }
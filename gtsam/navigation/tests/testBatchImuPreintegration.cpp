@@ -0,0 +1,97 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testBatchImuPreintegration.cpp
+ * @brief   Unit test for multi-hypothesis IMU preintegration
+ */
+
+#include <gtsam/navigation/BatchImuPreintegration.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include "imuFactorTesting.h"
+
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+
+namespace testing {
+// Create default parameters with Z-down and above noise parameters
+static boost::shared_ptr<PreintegrationParams> Params() {
+  auto p = PreintegrationParams::MakeSharedD(kGravity);
+  p->gyroscopeCovariance = kGyroSigma * kGyroSigma * I_3x3;
+  p->accelerometerCovariance = kAccelSigma * kAccelSigma * I_3x3;
+  p->integrationCovariance = 0.0001 * I_3x3;
+  return p;
+}
+
+// Five hypotheses, so the last SIMD block is only partially used
+static vector<Bias> Biases() {
+  vector<Bias> biases;
+  biases.push_back(kZeroBias);
+  biases.push_back(Bias(Vector3(0.1, 0, 0), Vector3(0, 0, 0.01)));
+  biases.push_back(Bias(Vector3(0, -0.2, 0.05), Vector3(0.02, 0, 0)));
+  biases.push_back(Bias(Vector3(0.3, 0.1, -0.1), Vector3(-0.01, 0.03, 0.02)));
+  biases.push_back(Bias(Vector3(-0.1, 0, 0.2), Vector3(0, -0.02, 0.01)));
+  return biases;
+}
+}
+
+/* ************************************************************************* */
+TEST(BatchImuPreintegration, MatchesSingleHypothesis) {
+  testing::SomeMeasurements measurements;
+  const vector<Bias> biases = testing::Biases();
+
+  BatchImuPreintegration batch(testing::Params(), biases);
+  testing::integrateMeasurements(measurements, &batch);
+  EXPECT_LONGS_EQUAL(biases.size(), batch.size());
+
+  const vector<PreintegratedImuMeasurements> actual = batch.all();
+  for (size_t i = 0; i < biases.size(); i++) {
+    PreintegratedImuMeasurements expected(testing::Params(), biases[i]);
+    testing::integrateMeasurements(measurements, &expected);
+    EXPECT(assert_equal(expected, actual[i], 1e-9));
+    EXPECT(assert_equal(expected.preintegrated_H_biasAcc(),
+                        actual[i].preintegrated_H_biasAcc(), 1e-9));
+    EXPECT(assert_equal(expected.preintegrated_H_biasOmega(),
+                        actual[i].preintegrated_H_biasOmega(), 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(BatchImuPreintegration, ResetIntegration) {
+  testing::SomeMeasurements measurements;
+  const vector<Bias> biases = testing::Biases();
+
+  BatchImuPreintegration batch(testing::Params(), biases);
+  testing::integrateMeasurements(measurements, &batch);
+  batch.resetIntegration();
+  EXPECT_DOUBLES_EQUAL(0.0, batch.deltaTij(), 1e-9);
+
+  const PreintegratedImuMeasurements expected(testing::Params(), biases[3]);
+  EXPECT(assert_equal(expected, batch.at(3)));
+}
+
+/* ************************************************************************* */
+TEST(BatchImuPreintegration, SensorPoseNotSupported) {
+  auto p = testing::Params();
+  p->body_P_sensor = Pose3(Rot3::Ypr(0.1, 0, 0), Point3(0.1, 0, 0));
+  CHECK_EXCEPTION(BatchImuPreintegration(p, testing::Biases()),
+                  std::domain_error);
+}
+
+#endif // GTSAM_TANGENT_PREINTEGRATION
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
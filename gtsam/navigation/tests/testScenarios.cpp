@@ -107,6 +107,25 @@ TEST(ScenarioRunner, ForwardWithBias) {
   EXPECT(assert_equal(estimatedCov, pim.preintMeasCov(), 0.1));
 }
 
+/* ************************************************************************* */
+TEST(ScenarioRunner, SampleErrorsDeterministic) {
+  using namespace forward;
+  ScenarioRunner runner(scenario, defaultParams(), kDt);
+  const double T = 0.1;  // seconds
+
+  // Samples only depend on their index, so runs can be split and repeated
+  Matrix all = runner.sampleErrors(T, 20, kNonZeroBias);
+  Matrix first = runner.sampleErrors(T, 10, kNonZeroBias);
+  Matrix second = runner.sampleErrors(T, 10, kNonZeroBias, 10);
+  EXPECT(assert_equal(Matrix(all.leftCols(10)), first, 0.0));
+  EXPECT(assert_equal(Matrix(all.rightCols(10)), second, 0.0));
+  EXPECT(first != second);
+
+  // And so are the estimators
+  EXPECT(assert_equal(runner.estimateCovariance(T, 50),
+                      runner.estimateCovariance(T, 50), 0.0));
+}
+
 /* ************************************************************************* */
 TEST(ScenarioRunner, Circle) {
   gttic(Circle);
@@ -125,7 +125,9 @@ GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
 /* ************************************************************************* */
 DoglegParams DoglegOptimizer::ensureHasOrdering(DoglegParams params, const NonlinearFactorGraph& graph) const {
   if (!params.ordering)
-    params.ordering = Ordering::Create(params.orderingType, graph);
+    params.ordering = params.orderingCache
+        ? params.orderingCache->create(params.orderingType, graph)
+        : Ordering::Create(params.orderingType, graph);
   return params;
 }
 
@@ -194,6 +194,8 @@ T Expression<T>::valueAndJacobianMap(const Values& values,
   // with modern C++ compilers. The traceExecution then fills this memory
   // with an execution trace, made up entirely of "Record" structs, see
   // the FunctionalNode class in expression-inl.h
+  // The offset of every Record is fixed by the shape of the expression tree,
+  // so the Records are packed back to back in traceSlots(size) elements.
   size_t size = traceSize();
 
   // Windows does not support variable length arrays, so memory must be dynamically
@@ -202,12 +204,10 @@ T Expression<T>::valueAndJacobianMap(const Values& values,
 #ifdef _MSC_VER
   auto traceStorage = static_cast<internal::ExecutionTraceStorage*>(_aligned_malloc(size, internal::TraceAlignment));
 #else
-  internal::ExecutionTraceStorage traceStorage[size];
+  internal::ExecutionTraceStorage traceStorage[internal::traceSlots(size)];
 #endif
 
-  internal::ExecutionTrace<T> trace;
-  T value(this->traceExecution(values, trace, traceStorage));
-  trace.startReverseAD1(jacobians);
+  T value(valueAndJacobianMap(values, jacobians, traceStorage));
 
 #ifdef _MSC_VER
   _aligned_free(traceStorage);
@@ -216,6 +216,16 @@ T Expression<T>::valueAndJacobianMap(const Values& values,
   return value;
 }
 
+template<typename T>
+T Expression<T>::valueAndJacobianMap(const Values& values,
+    internal::JacobianMap& jacobians, void* traceStorage) const {
+  assert(reinterpret_cast<size_t>(traceStorage) % internal::TraceAlignment == 0);
+  internal::ExecutionTrace<T> trace;
+  T value(this->traceExecution(values, trace, traceStorage));
+  trace.startReverseAD1(jacobians);
+  return value;
+}
+
 template<typename T>
 typename Expression<T>::KeysAndDims Expression<T>::keysAndDims() const {
   std::map<Key, int> map;
@@ -171,7 +171,7 @@ public:
   /// Return root
   const boost::shared_ptr<internal::ExpressionNode<T> >& root() const;
 
-  /// Return size needed for memory buffer in traceExecution
+  /// Return size in bytes needed for memory buffer in traceExecution
   size_t traceSize() const;
 
   /// Add another expression to this expression
@@ -198,6 +198,10 @@ protected:
   T valueAndJacobianMap(const Values& values,
       internal::JacobianMap& jacobians) const;
 
+  /// Same, but trace into caller-provided storage of at least traceSize() bytes
+  T valueAndJacobianMap(const Values& values, internal::JacobianMap& jacobians,
+      void* traceStorage) const;
+
   // be very selective on who can access these private methods:
   friend class ExpressionFactor<T> ;
   friend class internal::ExpressionNode<T>;
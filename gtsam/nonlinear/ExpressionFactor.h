@@ -22,16 +22,41 @@
 #include <gtsam/nonlinear/Expression.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/base/Testable.h>
+#include <boost/functional/hash.hpp>
 #include <numeric>
+#include <typeinfo>
 
 namespace gtsam {
 
+namespace internal {
+/**
+ * Type-erased view of an ExpressionFactor, used by ExpressionFactorGraph to
+ * group factors whose expressions have the same shape and linearize them as a
+ * batch, sharing one execution trace buffer.
+ */
+class BatchLinearizable {
+ public:
+  virtual ~BatchLinearizable() {}
+
+  /// Factors with equal shape have structurally identical expressions
+  virtual size_t shape() const = 0;
+
+  /// Size in bytes of the execution trace used during linearization
+  virtual size_t traceSize() const = 0;
+
+  /// Linearize, tracing into storage of at least traceSize() bytes
+  virtual boost::shared_ptr<GaussianFactor> linearizeWithStorage(
+      const Values& x, void* traceStorage) const = 0;
+};
+}
+
 /**
 
  * Factor that supports arbitrary expressions via AD
  */
 template<typename T>
-class ExpressionFactor: public NoiseModelFactor {
+class ExpressionFactor: public NoiseModelFactor,
+                        public internal::BatchLinearizable {
   BOOST_CONCEPT_ASSERT((IsTestable<T>));
 
 protected:
@@ -100,6 +125,29 @@ protected:
   }
 
   virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+    return linearizeWithStorage(x, 0);
+  }
+
+  /// Hash of the expression shape: result type, root node type, trace size and
+  /// Jacobian dimensions. Used to batch factors in ExpressionFactorGraph.
+  virtual size_t shape() const {
+    size_t seed = typeid(T).hash_code();
+    boost::hash_combine(seed, typeid(*expression_.root()).hash_code());
+    boost::hash_combine(seed, expression_.traceSize());
+    boost::hash_range(seed, dims_.begin(), dims_.end());
+    return seed;
+  }
+
+  /// Size in bytes of the execution trace used during linearization
+  virtual size_t traceSize() const { return expression_.traceSize(); }
+
+  /**
+   * Linearize, tracing the expression into traceStorage, which should hold
+   * at least traceSize() bytes aligned to internal::TraceAlignment.
+   * If traceStorage is null, a trace buffer is allocated on the stack.
+   */
+  virtual boost::shared_ptr<GaussianFactor> linearizeWithStorage(
+      const Values& x, void* traceStorage) const {
     // Only linearize if the factor is active
     if (!active(x))
       return boost::shared_ptr<JacobianFactor>();
@@ -123,7 +171,10 @@ protected:
     Ab.matrix().setZero();
 
     // Get value and Jacobians, writing directly into JacobianFactor
-    T value = expression_.valueAndJacobianMap(x, jacobianMap); // <<< Reverse AD happens here !
+    // <<< Reverse AD happens here !
+    T value = traceStorage
+        ? expression_.valueAndJacobianMap(x, jacobianMap, traceStorage)
+        : expression_.valueAndJacobianMap(x, jacobianMap);
 
     // Evaluate error and set RHS vector b
     Ab(size()).col(0) = traits<T>::Local(value, measured_);
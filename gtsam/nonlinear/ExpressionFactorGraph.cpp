@@ -0,0 +1,121 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  ExpressionFactorGraph.cpp
+ *  @brief Factor graph that supports adding ExpressionFactors directly
+ *  @date December 2014
+ */
+
+#include <gtsam/nonlinear/ExpressionFactorGraph.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+namespace {
+
+typedef pair<const internal::BatchLinearizable*, FactorIndex> BatchEntry;
+
+// Linearizes a range of batched factors, sharing one trace buffer
+class _LinearizeBatch {
+  const vector<BatchEntry>& batch_;
+  const Values& linearizationPoint_;
+  GaussianFactorGraph& result_;
+public:
+  _LinearizeBatch(const vector<BatchEntry>& batch,
+      const Values& linearizationPoint, GaussianFactorGraph& result) :
+      batch_(batch), linearizationPoint_(linearizationPoint), result_(result) {
+  }
+
+  void operator()(size_t begin, size_t end) const {
+    // Factors with the same shape are adjacent, so the buffer rarely grows
+    vector<internal::ExecutionTraceStorage> buffer;
+    for (size_t i = begin; i != end; ++i) {
+      const internal::BatchLinearizable& factor = *batch_[i].first;
+      // One extra slot so we can align the start of the trace
+      const size_t slots = internal::traceSlots(factor.traceSize()) + 1;
+      if (buffer.size() < slots)
+        buffer.resize(slots);
+      void* traceStorage = internal::upAligned(static_cast<void*>(buffer.data()));
+      result_[batch_[i].second] =
+          factor.linearizeWithStorage(linearizationPoint_, traceStorage);
+    }
+  }
+
+#ifdef GTSAM_USE_TBB
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    (*this)(blocked_range.begin(), blocked_range.end());
+  }
+#endif
+};
+
+} // namespace
+
+/* ************************************************************************* */
+boost::shared_ptr<GaussianFactorGraph> ExpressionFactorGraph::linearizeBatched(
+    const Values& linearizationPoint) const {
+  gttic(ExpressionFactorGraph_linearizeBatched);
+
+  boost::shared_ptr<GaussianFactorGraph> linearFG =
+      boost::make_shared<GaussianFactorGraph>();
+  linearFG->resize(size());
+
+  // Split off expression factors, and sort them by shape
+  vector<pair<size_t, BatchEntry> > shaped;
+  FactorIndices others;
+  for (size_t i = 0; i < size(); i++) {
+    if (!factors_[i])
+      continue;
+    const internal::BatchLinearizable* batchable =
+        dynamic_cast<const internal::BatchLinearizable*>(factors_[i].get());
+    if (batchable)
+      shaped.push_back(make_pair(batchable->shape(), BatchEntry(batchable, i)));
+    else
+      others.push_back(i);
+  }
+  stable_sort(shaped.begin(), shaped.end(),
+      [](const pair<size_t, BatchEntry>& a, const pair<size_t, BatchEntry>& b) {
+        return a.first < b.first;
+      });
+  vector<BatchEntry> batch;
+  batch.reserve(shaped.size());
+  for (const auto& entry : shaped)
+    batch.push_back(entry.second);
+
+  // Linearize all batches
+  _LinearizeBatch linearizeBatch(batch, linearizationPoint, *linearFG);
+#ifdef GTSAM_USE_TBB
+  TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, batch.size()), linearizeBatch);
+#else
+  linearizeBatch(0, batch.size());
+#endif
+
+  // Linearize remaining factors
+  for (FactorIndex i : others)
+    (*linearFG)[i] = factors_[i]->linearize(linearizationPoint);
+
+  return linearFG;
+}
+
+} // namespace gtsam
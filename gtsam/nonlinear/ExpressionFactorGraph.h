@@ -26,7 +26,7 @@ namespace gtsam {
 /**
  * Factor graph that supports adding ExpressionFactors directly
  */
-class ExpressionFactorGraph: public NonlinearFactorGraph {
+class GTSAM_EXPORT ExpressionFactorGraph: public NonlinearFactorGraph {
 
 public:
 
@@ -47,6 +47,23 @@ public:
   }
 
   /// @}
+
+  /// @name Linearization
+  /// @{
+
+  /**
+   * Linearize, batching ExpressionFactors with the same expression shape.
+   * In bundle adjustment, thousands of factors share one expression structure
+   * and differ only in keys and measurement. Those factors are linearized
+   * back to back (in parallel when TBB is enabled), reusing one execution
+   * trace buffer per batch instead of setting up a new trace per factor.
+   * Other factors are linearized as usual. The result is identical to
+   * NonlinearFactorGraph::linearize, with factors in the same order.
+   */
+  boost::shared_ptr<GaussianFactorGraph> linearizeBatched(
+      const Values& linearizationPoint) const;
+
+  /// @}
 };
 
 }
@@ -69,7 +69,9 @@ GaussianFactorGraph::shared_ptr GaussNewtonOptimizer::iterate() {
 GaussNewtonParams GaussNewtonOptimizer::ensureHasOrdering(
     GaussNewtonParams params, const NonlinearFactorGraph& graph) const {
   if (!params.ordering)
-    params.ordering = Ordering::Create(params.orderingType, graph);
+    params.ordering = params.orderingCache
+        ? params.orderingCache->create(params.orderingType, graph)
+        : Ordering::Create(params.orderingType, graph);
   return params;
 }
 
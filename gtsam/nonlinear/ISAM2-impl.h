@@ -64,8 +64,10 @@ class ISAM2JunctionTree
   typedef ISAM2JunctionTree This;
   typedef boost::shared_ptr<This> shared_ptr;
 
-  explicit ISAM2JunctionTree(const GaussianEliminationTree& eliminationTree)
-      : Base(eliminationTree) {}
+  explicit ISAM2JunctionTree(
+      const GaussianEliminationTree& eliminationTree,
+      const AmalgamationParams& amalgamation = AmalgamationParams())
+      : Base(eliminationTree, amalgamation) {}
 };
 
 /* ************************************************************************* */
@@ -524,7 +526,7 @@ struct GTSAM_EXPORT UpdateImpl {
     gttic(GetAffectedFactors);
     FactorIndexSet indices;
     for (const Key key : keys) {
-      const FactorIndices& factors(variableIndex[key]);
+      const VariableIndex::Factors factors(variableIndex[key]);
       indices.insert(factors.begin(), factors.end());
     }
     return indices;
@@ -176,8 +176,8 @@ void ISAM2::recalculateBatch(const ISAM2UpdateParams& updateParams,
   gttic(recalculateBatch);
 
   gttic(add_keys);
-  br::copy(variableIndex_ | br::map_keys,
-           std::inserter(*affectedKeysSet, affectedKeysSet->end()));
+  for (const VariableIndex::value_type key_factors : variableIndex_)
+    affectedKeysSet->insert(affectedKeysSet->end(), key_factors.first);
 
   // Removed unused keys:
   VariableIndex affectedFactorsVarIndex = variableIndex_;
@@ -216,7 +216,8 @@ void ISAM2::recalculateBatch(const ISAM2UpdateParams& updateParams,
   gttic(eliminate);
   ISAM2BayesTree::shared_ptr bayesTree =
       ISAM2JunctionTree(
-          GaussianEliminationTree(*linearized, affectedFactorsVarIndex, order))
+          GaussianEliminationTree(*linearized, affectedFactorsVarIndex, order),
+          params_.batchAmalgamation)
           .eliminate(params_.getEliminationFunction())
           .first;
   gttoc(eliminate);
@@ -328,7 +329,7 @@ void ISAM2::recalculateIncremental(const ISAM2UpdateParams& updateParams,
        /*Incremented in loop ++iter*/) {
     if (result->unusedKeys.exists(iter->first) ||
         !affectedKeysSet->exists(iter->first))
-      constraintGroups.erase(iter++);
+      iter = constraintGroups.erase(iter);
     else
       ++iter;
   }
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <gtsam/inference/JunctionTree.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/nonlinear/DoglegOptimizerImpl.h>
 #include <boost/variant.hpp>
@@ -223,6 +224,11 @@ struct GTSAM_EXPORT ISAM2Params {
   /// cost of having to search for slots every time a factor is added.
   bool findUnusedFactorSlots;
 
+  /// Controls how elimination tree nodes are merged into cliques when the whole
+  /// tree is re-eliminated in batch (default: exact merging only). Relaxed
+  /// amalgamation gives fewer, larger cliques at the cost of some fill-in.
+  AmalgamationParams batchAmalgamation;
+
   /**
    * Specify parameters as constructor arguments
    * See the documentation of member variables above.
@@ -288,6 +294,9 @@ struct GTSAM_EXPORT ISAM2Params {
          << enablePartialRelinearizationCheck << "\n";
     cout << "findUnusedFactorSlots:             " << findUnusedFactorSlots
          << "\n";
+    cout << "batchAmalgamation:                 "
+         << batchAmalgamation.maxZeroFraction << " zeros, "
+         << batchAmalgamation.maxFrontals << " frontals\n";
     cout.flush();
   }
 
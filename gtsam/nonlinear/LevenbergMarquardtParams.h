@@ -109,7 +109,9 @@ public:
   static LevenbergMarquardtParams EnsureHasOrdering(LevenbergMarquardtParams params,
                                                     const NonlinearFactorGraph& graph) {
     if (!params.ordering)
-      params.ordering = Ordering::Create(params.orderingType, graph);
+      params.ordering = params.orderingCache
+          ? params.orderingCache->create(params.orderingType, graph)
+          : Ordering::Create(params.orderingType, graph);
     return params;
   }
 
@@ -115,6 +115,9 @@ void NonlinearOptimizerParams::print(const std::string& str) const {
   case Ordering::METIS:
     std::cout << "                   ordering: METIS\n";
     break;
+  case Ordering::NESTED_DISSECTION:
+    std::cout << "                   ordering: NESTED_DISSECTION\n";
+    break;
   default:
     std::cout << "                   ordering: custom\n";
     break;
@@ -170,6 +173,8 @@ std::string NonlinearOptimizerParams::orderingTypeTranslator(
   switch (type) {
   case Ordering::METIS:
     return "METIS";
+  case Ordering::NESTED_DISSECTION:
+    return "NESTED_DISSECTION";
   case Ordering::COLAMD:
     return "COLAMD";
   default:
@@ -186,6 +191,8 @@ Ordering::OrderingType NonlinearOptimizerParams::orderingTypeTranslator(
     const std::string& type) const {
   if (type == "METIS")
     return Ordering::METIS;
+  if (type == "NESTED_DISSECTION")
+    return Ordering::NESTED_DISSECTION;
   if (type == "COLAMD")
     return Ordering::COLAMD;
   throw std::invalid_argument(
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <gtsam/inference/OrderingCache.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/SubgraphSolver.h>
 #include <boost/optional.hpp>
@@ -83,6 +84,7 @@ public:
 
   LinearSolverType linearSolverType; ///< The type of linear solver to use in the nonlinear optimizer
   boost::optional<Ordering> ordering; ///< The variable elimination ordering, or empty to use COLAMD (default: empty)
+  OrderingCache::shared_ptr orderingCache; ///< If set, orderings are looked up in and stored to this cache, shared across optimizer runs (default: none)
   IterativeOptimizationParameters::shared_ptr iterativeParams; ///< The container for iterativeOptimization parameters. used in CG Solvers.
 
   inline bool isMultifrontal() const {
@@ -24,6 +24,12 @@
 
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/parallel_for.h>
+#endif
 
 #ifdef __GNUC__
 #pragma GCC diagnostic push
@@ -53,18 +59,100 @@ namespace gtsam {
   }
 
   /* ************************************************************************* */
-  Values::Values(const Values& other, const VectorValues& delta) {
-    for (const_iterator key_value = other.begin(); key_value != other.end(); ++key_value) {
-      VectorValues::const_iterator it = delta.find(key_value->key);
-      Key key = key_value->key;  // Non-const duplicate to deal with non-const insert argument
-      if (it != delta.end()) {
-        const Vector& v = it->second;
-        Value* retractedValue(key_value->value.retract_(v));  // Retract
-        values_.insert(key, retractedValue);  // Add retracted result directly to result values
-      } else {
-        values_.insert(key, key_value->value.clone_());  // Add original version to result values
+  namespace {
+
+  typedef std::pair<Key, const Value*> KeyValuePtr;
+
+  // Retracts, or clones if there is no update, a range of values into a
+  // presized array of pool-allocated results
+  class _RetractValues {
+    const vector<KeyValuePtr>& values_;
+    const VectorValues& delta_;
+    vector<Value*>& result_;
+  public:
+    _RetractValues(const vector<KeyValuePtr>& values, const VectorValues& delta,
+        vector<Value*>& result) :
+        values_(values), delta_(delta), result_(result) {
+    }
+
+    void operator()(size_t begin, size_t end) const {
+      for (size_t i = begin; i != end; ++i) {
+        VectorValues::const_iterator it = delta_.find(values_[i].first);
+        if (it != delta_.end())
+          result_[i] = values_[i].second->retract_(it->second);
+        else
+          result_[i] = values_[i].second->clone_();
       }
     }
+
+#ifdef GTSAM_USE_TBB
+    void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+      (*this)(blocked_range.begin(), blocked_range.end());
+    }
+#endif
+  };
+
+  // Computes local coordinates of a range of value pairs with matching keys
+  class _LocalCoordinates {
+    const vector<KeyValuePtr>& values_;
+    const vector<const Value*>& others_;
+    vector<std::pair<Key, Vector> >& result_;
+  public:
+    _LocalCoordinates(const vector<KeyValuePtr>& values,
+        const vector<const Value*>& others, vector<std::pair<Key, Vector> >& result) :
+        values_(values), others_(others), result_(result) {
+    }
+
+    void operator()(size_t begin, size_t end) const {
+      for (size_t i = begin; i != end; ++i) {
+        result_[i].first = values_[i].first;
+        // Will throw a dynamic_cast exception if types do not match
+        result_[i].second = values_[i].second->localCoordinates_(*others_[i]);
+      }
+    }
+
+#ifdef GTSAM_USE_TBB
+    void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+      (*this)(blocked_range.begin(), blocked_range.end());
+    }
+#endif
+  };
+
+  // Flatten the map so the values can be processed by index
+  vector<KeyValuePtr> flatten(const Values& values) {
+    vector<KeyValuePtr> result;
+    result.reserve(values.size());
+    for (Values::const_iterator it = values.begin(); it != values.end(); ++it)
+      result.push_back(KeyValuePtr(it->key, &it->value));
+    return result;
+  }
+
+  } // namespace
+
+  /* ************************************************************************* */
+  Values::Values(const Values& other, const VectorValues& delta) {
+    gttic(Values_retract);
+    const vector<KeyValuePtr> sources = flatten(other);
+    vector<Value*> retracted(sources.size(), 0);
+    _RetractValues retractValues(sources, delta, retracted);
+    try {
+#ifdef GTSAM_USE_TBB
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, sources.size()), retractValues);
+#else
+      retractValues(0, sources.size());
+#endif
+    } catch (...) {
+      for (Value* value : retracted)
+        if (value)
+          value->deallocate_();
+      throw;
+    }
+
+    // Keys are sorted, so inserting at the end never searches the map
+    for (size_t i = 0; i < sources.size(); ++i) {
+      Key key = sources[i].first;  // Non-const duplicate to deal with non-const insert argument
+      values_.insert(values_.end(), key, retracted[i]);
+    }
   }
 
   /* ************************************************************************* */
@@ -105,17 +193,28 @@ namespace gtsam {
 
   /* ************************************************************************* */
   VectorValues Values::localCoordinates(const Values& cp) const {
+    gttic(Values_localCoordinates);
     if(this->size() != cp.size())
       throw DynamicValuesMismatched();
-    VectorValues result;
-    for(const_iterator it1=this->begin(), it2=cp.begin(); it1!=this->end(); ++it1, ++it2) {
-      if(it1->key != it2->key)
+    const vector<KeyValuePtr> values = flatten(*this);
+    vector<const Value*> others;
+    others.reserve(cp.size());
+    size_t i = 0;
+    for(const_iterator it2=cp.begin(); it2!=cp.end(); ++it2, ++i) {
+      if(values[i].first != it2->key)
         throw DynamicValuesMismatched(); // If keys do not match
-      // Will throw a dynamic_cast exception if types do not match
-      // NOTE: this is separate from localCoordinates(cp, ordering, result) due to at() vs. insert
-      result.insert(it1->key, it1->value.localCoordinates_(it2->value));
+      others.push_back(&it2->value);
     }
-    return result;
+
+    // NOTE: this is separate from localCoordinates(cp, ordering, result) due to at() vs. insert
+    vector<std::pair<Key, Vector> > result(values.size());
+    _LocalCoordinates localCoordinates(values, others, result);
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, values.size()), localCoordinates);
+#else
+    localCoordinates(0, values.size());
+#endif
+    return VectorValues(result.begin(), result.end());
   }
 
   /* ************************************************************************* */
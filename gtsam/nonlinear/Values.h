@@ -242,10 +242,12 @@ namespace gtsam {
     /// @name Manifold Operations
     /// @{
 
-    /** Add a delta config to current config and returns a new config */
+    /** Add a delta config to current config and returns a new config. Values
+     *  are retracted in parallel when GTSAM is built with TBB. */
     Values retract(const VectorValues& delta) const;
 
-    /** Get a delta config about a linearization point c0 (*this) */
+    /** Get a delta config about a linearization point c0 (*this). Computed in
+     *  parallel when GTSAM is built with TBB. */
     VectorValues localCoordinates(const Values& cp) const;
 
     ///@}
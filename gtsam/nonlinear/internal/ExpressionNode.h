@@ -51,6 +51,18 @@ T upAligned(T value, unsigned requiredAlignment = TraceAlignment) {
   return upAlign(value, requiredAlignment);
 }
 
+/**
+ * Trace sizes are expressed in bytes, but traces are laid out in an array of
+ * ExecutionTraceStorage elements, each TraceAlignment bytes wide. This returns
+ * the number of elements to skip to jump over a trace of the given size, so
+ * records are packed contiguously at offsets that only depend on the shape of
+ * the expression tree.
+ */
+inline size_t traceSlots(size_t traceSize) {
+  BOOST_STATIC_ASSERT(sizeof(ExecutionTraceStorage) == TraceAlignment);
+  return upAligned(traceSize) / TraceAlignment;
+}
+
 //-----------------------------------------------------------------------------
 
 /**
@@ -275,7 +287,7 @@ public:
 
     /// Construct record by calling argument expression
     Record(const Values& values, const ExpressionNode<A1>& expression1, ExecutionTraceStorage* ptr)
-        : value1(expression1.traceExecution(values, trace1, ptr + upAligned(sizeof(Record)))) {}
+        : value1(expression1.traceExecution(values, trace1, ptr + traceSlots(sizeof(Record)))) {}
 
     /// Print to std::cout
     void print(const std::string& indent) const {
@@ -398,8 +410,8 @@ public:
     /// Construct record by calling argument expressions
     Record(const Values& values, const ExpressionNode<A1>& expression1,
            const ExpressionNode<A2>& expression2, ExecutionTraceStorage* ptr)
-        : value1(expression1.traceExecution(values, trace1, ptr += upAligned(sizeof(Record)))),
-          value2(expression2.traceExecution(values, trace2, ptr += expression1.traceSize())) {}
+        : value1(expression1.traceExecution(values, trace1, ptr += traceSlots(sizeof(Record)))),
+          value2(expression2.traceExecution(values, trace2, ptr += traceSlots(expression1.traceSize()))) {}
 
     /// Print to std::cout
     void print(const std::string& indent) const {
@@ -512,9 +524,9 @@ public:
     Record(const Values& values, const ExpressionNode<A1>& expression1,
            const ExpressionNode<A2>& expression2,
            const ExpressionNode<A3>& expression3, ExecutionTraceStorage* ptr)
-        : value1(expression1.traceExecution(values, trace1, ptr += upAligned(sizeof(Record)))),
-          value2(expression2.traceExecution(values, trace2, ptr += expression1.traceSize())),
-          value3(expression3.traceExecution(values, trace3, ptr += expression2.traceSize())) {}
+        : value1(expression1.traceExecution(values, trace1, ptr += traceSlots(sizeof(Record)))),
+          value2(expression2.traceExecution(values, trace2, ptr += traceSlots(expression1.traceSize()))),
+          value3(expression3.traceExecution(values, trace3, ptr += traceSlots(expression2.traceSize()))) {}
 
     /// Print to std::cout
     void print(const std::string& indent) const {
@@ -626,9 +638,9 @@ class ScalarMultiplyNode : public ExpressionNode<T> {
                            ExecutionTraceStorage* ptr) const {
     assert(reinterpret_cast<size_t>(ptr) % TraceAlignment == 0);
     Record* record = new (ptr) Record();
-    ptr += upAligned(sizeof(Record));
+    ptr += traceSlots(sizeof(Record));
     T value = expression_->traceExecution(values, record->trace, ptr);
-    ptr += expression_->traceSize();
+    ptr += traceSlots(expression_->traceSize());
     trace.setFunction(record);
     record->scalar_dTdA = scalar_;
     return scalar_ * value;
@@ -721,8 +733,8 @@ class BinarySumNode : public ExpressionNode<T> {
     Record* record = new (ptr) Record();
     trace.setFunction(record);
 
-    ExecutionTraceStorage* ptr1 = ptr + upAligned(sizeof(Record));
-    ExecutionTraceStorage* ptr2 = ptr1 + expression1_->traceSize();
+    ExecutionTraceStorage* ptr1 = ptr + traceSlots(sizeof(Record));
+    ExecutionTraceStorage* ptr2 = ptr1 + traceSlots(expression1_->traceSize());
     return expression1_->traceExecution(values, record->trace1, ptr1) +
            expression2_->traceExecution(values, record->trace2, ptr2);
   }
@@ -246,6 +246,16 @@ TEST(Expression, TreeTraceSize) {
                      tree::uv_hat.traceSize());
 }
 
+/* ************************************************************************* */
+// Records are packed back to back: storage needs one slot per TraceAlignment bytes
+TEST(Expression, TreeTraceSlots) {
+  const size_t size = tree::uv_hat.traceSize();
+  EXPECT_LONGS_EQUAL(0, size % internal::TraceAlignment);
+  EXPECT_LONGS_EQUAL(size / internal::TraceAlignment, internal::traceSlots(size));
+  EXPECT_LONGS_EQUAL(size, sizeof(internal::ExecutionTraceStorage) *
+                               internal::traceSlots(size));
+}
+
 /* ************************************************************************* */
 TEST(Expression, compose1) {
   // Create expression
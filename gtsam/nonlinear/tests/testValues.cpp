@@ -269,6 +269,44 @@ TEST(Values, localCoordinates)
   EXPECT(assert_equal(expDelta, valuesA.localCoordinates(valuesB)));
 }
 
+/* ************************************************************************* */
+TEST(Values, retractAndLocalCoordinatesMany)
+{
+  // Enough values of mixed types to be split across threads
+  Values values;
+  VectorValues delta;
+  for (size_t j = 0; j < 5000; j++) {
+    if (j % 2 == 0)
+      values.insert(j, Pose2(0.01 * j, 0.0, 0.001 * j));
+    else
+      values.insert(j, Vector3(1.0, 2.0, 0.1 * j));
+    if (j % 3 != 0)
+      delta.insert(j, Vector3(0.1, -0.2, 0.3));
+  }
+
+  Values expected;
+  for (const auto& key_value : values) {
+    VectorValues::const_iterator it = delta.find(key_value.key);
+    if (it != delta.end()) {
+      Value* retracted = key_value.value.retract_(it->second);
+      expected.insert(key_value.key, *retracted);
+      retracted->deallocate_();
+    } else {
+      expected.insert(key_value.key, key_value.value);
+    }
+  }
+  const Values actual = values.retract(delta);
+  EXPECT(assert_equal(expected, actual));
+
+  const VectorValues local = values.localCoordinates(actual);
+  LONGS_EQUAL(values.size(), local.size());
+  for (const auto& key_value : local) {
+    VectorValues::const_iterator it = delta.find(key_value.first);
+    const Vector expectedLocal = it != delta.end() ? it->second : Vector(Z_3x1);
+    EXPECT(assert_equal(expectedLocal, key_value.second, 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 TEST(Values, extract_keys)
 {
@@ -24,6 +24,9 @@
 
 #include <boost/assign/std/list.hpp>
 #include <boost/assign/list_of.hpp>
+
+#include <algorithm>
+
 using namespace boost::assign;
 
 using namespace std;
@@ -143,6 +146,52 @@ TEST(VariableIndex, deep_copy) {
   EXPECT(assert_equal(expectedRemoved, clone));
 }
 
+/* ************************************************************************* */
+TEST(VariableIndex, incremental) {
+  // Interleave many small augments and removals, so that segments move to the
+  // end of the storage and dead space is reclaimed several times
+  SymbolicFactorGraph graph;
+  VariableIndex actual;
+  for (size_t i = 0; i < 200; ++i) {
+    SymbolicFactorGraph newFactors;
+    newFactors.push_factor(i % 7, 10 + i % 13);
+    newFactors.push_factor(100 + i);
+    actual.augment(newFactors);
+    graph.push_back(newFactors);
+    if (i >= 5 && i % 2 == 0) {
+      // Remove the two factors added five steps ago, and the unary's variable
+      FactorIndices indices;
+      indices.push_back(2 * (i - 5));
+      indices.push_back(2 * (i - 5) + 1);
+      SymbolicFactorGraph removed;
+      removed.push_back(graph[indices[0]]);
+      removed.push_back(graph[indices[1]]);
+      actual.remove(indices.begin(), indices.end(), removed);
+      graph.remove(indices[0]);
+      graph.remove(indices[1]);
+      KeyVector unused;
+      unused.push_back(100 + i - 5);
+      actual.removeUnusedVariables(unused.begin(), unused.end());
+    }
+  }
+
+  // The same as building the index from scratch
+  VariableIndex expected(graph);
+  EXPECT(assert_equal(expected, actual));
+  LONGS_EQUAL(400, actual.nFactors());
+  LONGS_EQUAL(7 + 13 + 103, actual.size());
+  EXPECT(actual.find(101) == actual.end());
+  CHECK_EXCEPTION(actual[101], std::invalid_argument);
+
+  // Factors of each variable stay in the order they were added
+  const VariableIndex::Factors factors = actual[3];
+  EXPECT(std::is_sorted(factors.begin(), factors.end()));
+  LONGS_EQUAL(expected[3].size(), factors.size());
+
+  actual.compact();
+  EXPECT(assert_equal(expected, actual));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -169,7 +169,8 @@ private:
       const std::map<Key, DiscreteKey>& allDiscreteKeys) const {
     StarGraphs starGraphs;
     VariableIndex varIndex(graph); ///< access to all factors of each node
-    for(Key key: varIndex | boost::adaptors::map_keys) {
+    for(const VariableIndex::value_type key_factors: varIndex) {
+      const Key key = key_factors.first;
       // initialize to multiply with other unary factors later
       DecisionTreeFactor::shared_ptr prodOfUnaries;
 
@@ -178,7 +178,11 @@ void BatchFixedLagSmoother::eraseKeys(const KeyVector& keys) {
 /* ************************************************************************* */
 void BatchFixedLagSmoother::reorder(const KeyVector& marginalizeKeys) {
   // COLAMD groups will be used to place marginalize keys in Group 0, and everything else in Group 1
-  ordering_ = Ordering::ColamdConstrainedFirst(factors_, marginalizeKeys);
+  if (parameters_.orderingCache)
+    ordering_ = parameters_.orderingCache->create(Ordering::COLAMD, factors_,
+                                                  marginalizeKeys);
+  else
+    ordering_ = Ordering::ColamdConstrainedFirst(factors_, marginalizeKeys);
 }
 
 /* ************************************************************************* */
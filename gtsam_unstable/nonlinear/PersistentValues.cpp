@@ -0,0 +1,150 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file PersistentValues.cpp
+ * @brief A persistent (copy-on-write) variant of Values, for cheap snapshots
+ */
+
+#include <gtsam_unstable/nonlinear/PersistentValues.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/timing.h>
+
+#include <iostream>
+#include <typeinfo>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+PersistentValues::PersistentValues(const Values& values) : size_(0) {
+  insert(values);
+}
+
+/* ************************************************************************* */
+void PersistentValues::print(const string& str, const KeyFormatter& keyFormatter) const {
+  cout << str << "PersistentValues with " << size() << " values:" << endl;
+  for (const Tree::value_type& key_value : tree_) {
+    cout << "Value " << keyFormatter(key_value.first) << ": ";
+    key_value.second->print("");
+    cout << "\n";
+  }
+}
+
+/* ************************************************************************* */
+bool PersistentValues::equals(const PersistentValues& other, double tol) const {
+  if (same(other))
+    return true;
+  if (size() != other.size())
+    return false;
+  for (const_iterator it1 = begin(), it2 = other.begin(); it1 != end(); ++it1, ++it2) {
+    const Value& value1 = *it1->second;
+    const Value& value2 = *it2->second;
+    if (it1->first != it2->first || (it1->second != it2->second
+        && (typeid(value1) != typeid(value2) || !value1.equals_(value2, tol))))
+      return false;
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+const PersistentValues::sharedValue& PersistentValues::shared(Key j) const {
+  try {
+    return tree_.find(j);
+  } catch (const std::invalid_argument&) {
+    throw ValuesKeyDoesNotExist("retrieve", j);
+  }
+}
+
+/* ************************************************************************* */
+const Value& PersistentValues::at(Key j) const {
+  return *shared(j);
+}
+
+/* ************************************************************************* */
+KeyVector PersistentValues::keys() const {
+  KeyVector result;
+  result.reserve(size());
+  for (const Tree::value_type& key_value : tree_)
+    result.push_back(key_value.first);
+  return result;
+}
+
+/* ************************************************************************* */
+Values PersistentValues::values() const {
+  Values result;
+  for (const Tree::value_type& key_value : tree_)
+    result.insert(key_value.first, *key_value.second);
+  return result;
+}
+
+/* ************************************************************************* */
+PersistentValues PersistentValues::retract(const VectorValues& delta) const {
+  gttic(PersistentValues_retract);
+  PersistentValues result = *this;
+  for (const VectorValues::KeyValuePair& key_delta : delta) {
+    if (key_delta.second.isZero(0.0)) {
+      if (!exists(key_delta.first))
+        throw ValuesKeyDoesNotExist("retract", key_delta.first);
+      continue;
+    }
+    // retract_ allocates like clone_, hence the custom deleter
+    const sharedValue retracted(at(key_delta.first).retract_(key_delta.second),
+        [](const Value* value) { value->deallocate_(); });
+    result.tree_ = result.tree_.add(key_delta.first, retracted);
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+void PersistentValues::insert(Key j, const Value& val) {
+  if (exists(j))
+    throw ValuesKeyAlreadyExists(j);
+  tree_ = tree_.add(j, sharedValue(val.clone()));
+  ++size_;
+}
+
+/* ************************************************************************* */
+void PersistentValues::insert(const Values& values) {
+  for (const Values::ConstKeyValuePair& key_value : values)
+    insert(key_value.key, key_value.value);
+}
+
+/* ************************************************************************* */
+void PersistentValues::update(Key j, const Value& val) {
+  const Value& old_value = at(j);
+  if (typeid(old_value) != typeid(val))
+    throw ValuesIncorrectType(j, typeid(old_value), typeid(val));
+  tree_ = tree_.add(j, sharedValue(val.clone()));
+}
+
+/* ************************************************************************* */
+void PersistentValues::update(const Values& values, double tol) {
+  gttic(PersistentValues_update);
+  for (const Values::ConstKeyValuePair& key_value : values) {
+    const Value& old_value = at(key_value.key);
+    if (typeid(old_value) == typeid(key_value.value)
+        && old_value.equals_(key_value.value, tol))
+      continue;
+    update(key_value.key, key_value.value);
+  }
+}
+
+/* ************************************************************************* */
+void PersistentValues::erase(Key j) {
+  if (!exists(j))
+    throw ValuesKeyDoesNotExist("erase", j);
+  tree_ = tree_.remove(j);
+  --size_;
+}
+
+} // namespace gtsam
@@ -0,0 +1,170 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file PersistentValues.h
+ * @brief A persistent (copy-on-write) variant of Values, for cheap snapshots
+ */
+
+#pragma once
+
+#include <gtsam_unstable/base/BTree.h>
+#include <gtsam_unstable/dllexport.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace gtsam {
+
+/**
+ * A persistent variant of Values, stored in a functional AVL tree (BTree) of
+ * shared, immutable values. Copying a PersistentValues is O(1) and never
+ * copies a value, so it is cheap to take a snapshot of an estimate after every
+ * update, e.g., for logging, or to hand to readers on other threads.
+ *
+ * Modifying a PersistentValues takes O(log n) time and only copies the path
+ * from the root to the modified key: all other values remain shared with
+ * earlier snapshots, which are never affected. Snapshots may be read from
+ * several threads at once, but a single PersistentValues object should be
+ * modified by one thread at a time, as for any other container.
+ *
+ * The interface follows Values where it can. Use values() to convert to a
+ * Values, e.g., as the initial estimate of an optimizer.
+ * @addtogroup nonlinear
+ */
+class GTSAM_UNSTABLE_EXPORT PersistentValues {
+
+public:
+  typedef boost::shared_ptr<const Value> sharedValue; ///< Shared, immutable value
+  typedef BTree<Key, sharedValue> Tree; ///< The underlying functional tree
+  typedef Tree::const_iterator const_iterator; ///< Iterates over (Key, sharedValue) pairs, in key order
+
+private:
+  Tree tree_;
+  size_t size_; ///< Cached, as BTree::size is O(n)
+
+public:
+
+  /// @name Standard Constructors
+  /// @{
+
+  /** Default constructor creates an empty PersistentValues */
+  PersistentValues() : size_(0) {}
+
+  /** Construct from Values, copies every value once */
+  explicit PersistentValues(const Values& values);
+
+  /// @}
+  /// @name Testable
+  /// @{
+
+  /** print method for testing and debugging */
+  void print(const std::string& str = "", const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
+
+  /** Test whether the sets of keys and values are identical */
+  bool equals(const PersistentValues& other, double tol=1e-9) const;
+
+  /// @}
+  /// @name Standard Interface
+  /// @{
+
+  /** The number of variables */
+  size_t size() const { return size_; }
+
+  /** whether the config is empty */
+  bool empty() const { return size_ == 0; }
+
+  /** Check if a value exists with key \c j. */
+  bool exists(Key j) const { return tree_.mem(j); }
+
+  /** Retrieve a variable by key \c j. Throws ValuesKeyDoesNotExist if it does not exist. */
+  const Value& at(Key j) const;
+
+  /** Retrieve a variable by key \c j, and check its type as in Values::at. */
+  template<typename ValueType>
+  ValueType at(Key j) const {
+    return internal::handle<ValueType>()(j, &at(j));
+  }
+
+  /** Retrieve the shared value at key \c j, without copying it */
+  const sharedValue& shared(Key j) const;
+
+  /** Whether this and \c other are the very same snapshot, a constant time check */
+  bool same(const PersistentValues& other) const { return tree_.same(other.tree_); }
+
+  const_iterator begin() const { return tree_.begin(); }
+  const_iterator end() const { return tree_.end(); }
+
+  /** Returns a vector of keys in the config. */
+  KeyVector keys() const;
+
+  /** Convert to a Values, copies every value */
+  Values values() const;
+
+  /// @}
+  /// @name Manifold Operations
+  /// @{
+
+  /**
+   * Add a delta config to current config and return a new config. Values
+   * whose delta is exactly zero, or that are not in \c delta, are shared
+   * with this config rather than copied.
+   */
+  PersistentValues retract(const VectorValues& delta) const;
+
+  /// @}
+  /// @name Modifying (each is O(log n), and leaves all copies unaffected)
+  /// @{
+
+  /** Add a variable with the selected type, throws ValuesKeyAlreadyExists if it exists */
+  void insert(Key j, const Value& val);
+
+  /** Templated version to add a variable with the given type */
+  template <typename ValueType>
+  void insert(Key j, const ValueType& val) {
+    insert(j, static_cast<const Value&>(GenericValue<ValueType>(val)));
+  }
+
+  /** Add a set of variables, throws ValuesKeyAlreadyExists if a key is already present */
+  void insert(const Values& values);
+
+  /** Single element change of existing element, throws ValuesKeyDoesNotExist if it does not exist */
+  void update(Key j, const Value& val);
+
+  /** Templated version to update a variable with the given type */
+  template <typename T>
+  void update(Key j, const T& val) {
+    update(j, static_cast<const Value&>(GenericValue<T>(val)));
+  }
+
+  /**
+   * Update a set of variables, e.g., with a new estimate. Values that equal the
+   * stored value within \c tol keep sharing the stored value, so successive
+   * estimates only store what changed. Throws ValuesKeyDoesNotExist if a key
+   * does not exist.
+   */
+  void update(const Values& values, double tol = 1e-9);
+
+  /** Remove a variable from the config, throws ValuesKeyDoesNotExist if it does not exist */
+  void erase(Key j);
+
+  /** Remove all variables from the config */
+  void clear() { tree_ = Tree(); size_ = 0; }
+
+  /// @}
+};
+
+/// traits
+template<>
+struct traits<PersistentValues> : public Testable<PersistentValues> {
+};
+
+} // namespace gtsam
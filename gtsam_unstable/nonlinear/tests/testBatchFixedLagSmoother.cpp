@@ -238,6 +238,35 @@ TEST( BatchFixedLagSmoother, Example )
   }
 }
 
+/* ************************************************************************* */
+TEST( BatchFixedLagSmoother, OrderingCache )
+{
+  // Orderings updated incrementally give the same (linear) solution
+  SharedDiagonal odometerNoise = noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.1));
+  typedef BatchFixedLagSmoother::KeyTimestampMap Timestamps;
+  LevenbergMarquardtParams parameters;
+  parameters.orderingCache = boost::make_shared<OrderingCache>(1, true, 0.25);
+  BatchFixedLagSmoother expected(7.0), actual(7.0, parameters);
+
+  for (size_t i = 0; i <= 20; ++i) {
+    NonlinearFactorGraph newFactors;
+    Values newValues;
+    Timestamps newTimestamps;
+    const Key key = i;
+    if (i == 0)
+      newFactors.push_back(PriorFactor<Point2>(key, Point2(0.0, 0.0), odometerNoise));
+    else
+      newFactors.push_back(BetweenFactor<Point2>(key - 1, key, Point2(1.0, 0.0), odometerNoise));
+    newValues.insert(key, Point2(double(i) + 0.1, -0.1));
+    newTimestamps[key] = double(i);
+
+    expected.update(newFactors, newValues, newTimestamps);
+    actual.update(newFactors, newValues, newTimestamps);
+    CHECK(assert_equal(expected.calculateEstimate(), actual.calculateEstimate()));
+  }
+  CHECK(parameters.orderingCache->nrIncremental() > 0);
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
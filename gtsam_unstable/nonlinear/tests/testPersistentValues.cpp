@@ -0,0 +1,114 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testPersistentValues.cpp
+ * @brief   Unit tests for PersistentValues
+ */
+
+#include <gtsam_unstable/nonlinear/PersistentValues.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/linear/VectorValues.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+using symbol_shorthand::L;
+
+/* ************************************************************************* */
+static Values values() {
+  Values result;
+  for (size_t i = 0; i < 5; i++)
+    result.insert(X(i), Pose2(i, 0.1 * i, 0.01 * i));
+  result.insert(L(0), Point2(1, 2));
+  return result;
+}
+
+/* ************************************************************************* */
+TEST(PersistentValues, constructor) {
+  const Values expected = values();
+  const PersistentValues actual(expected);
+  LONGS_EQUAL(6, actual.size());
+  EXPECT(actual.exists(X(3)));
+  EXPECT(!actual.exists(X(5)));
+  EXPECT(assert_equal(Pose2(3, 0.3, 0.03), actual.at<Pose2>(X(3))));
+  EXPECT(assert_equal(Point2(1, 2), actual.at<Point2>(L(0))));
+  EXPECT(assert_equal(expected, actual.values()));
+  EXPECT(expected.keys() == actual.keys());
+  CHECK_EXCEPTION(actual.at(X(5)), ValuesKeyDoesNotExist);
+  CHECK_EXCEPTION(actual.at<Point2>(X(3)), ValuesIncorrectType);
+}
+
+/* ************************************************************************* */
+TEST(PersistentValues, snapshots) {
+  PersistentValues current(values());
+  const PersistentValues snapshot = current;
+  EXPECT(snapshot.same(current));
+
+  current.update(X(2), Pose2(7, 7, 0.7));
+  current.insert(X(5), Pose2());
+  current.erase(L(0));
+  CHECK_EXCEPTION(current.insert(X(5), Pose2()), ValuesKeyAlreadyExists);
+  CHECK_EXCEPTION(current.update(L(0), Point2()), ValuesKeyDoesNotExist);
+  CHECK_EXCEPTION(current.update(X(1), Point2()), ValuesIncorrectType);
+  CHECK_EXCEPTION(current.erase(L(0)), ValuesKeyDoesNotExist);
+
+  // The snapshot is not affected
+  EXPECT(!snapshot.same(current));
+  EXPECT(assert_equal(values(), snapshot.values()));
+  LONGS_EQUAL(6, current.size());
+  EXPECT(assert_equal(Pose2(7, 7, 0.7), current.at<Pose2>(X(2))));
+
+  // Unmodified values are shared
+  EXPECT(snapshot.shared(X(1)) == current.shared(X(1)));
+  EXPECT(snapshot.shared(X(2)) != current.shared(X(2)));
+}
+
+/* ************************************************************************* */
+TEST(PersistentValues, retract) {
+  const PersistentValues theta(values());
+  VectorValues delta;
+  delta.insert(X(1), Vector3(0.1, 0.2, 0.3));
+  delta.insert(X(2), Vector3::Zero());
+
+  const PersistentValues actual = theta.retract(delta);
+  EXPECT(assert_equal(values().retract(delta), actual.values()));
+  EXPECT(theta.shared(X(1)) != actual.shared(X(1)));
+  EXPECT(theta.shared(X(2)) == actual.shared(X(2)));
+  EXPECT(theta.shared(X(3)) == actual.shared(X(3)));
+
+  delta.insert(X(7), Vector3::Zero());
+  CHECK_EXCEPTION(theta.retract(delta), ValuesKeyDoesNotExist);
+}
+
+/* ************************************************************************* */
+TEST(PersistentValues, updateValues) {
+  PersistentValues current(values());
+  const PersistentValues snapshot = current;
+
+  // A new estimate in which only X(4) moved
+  Values estimate = values();
+  estimate.update(X(4), Pose2(4, 0.4, 0.05));
+  current.update(estimate);
+
+  EXPECT(assert_equal(estimate, current.values()));
+  EXPECT(snapshot.shared(X(0)) == current.shared(X(0)));
+  EXPECT(snapshot.shared(L(0)) == current.shared(L(0)));
+  EXPECT(snapshot.shared(X(4)) != current.shared(X(4)));
+  EXPECT(!snapshot.equals(current));
+  EXPECT(assert_equal(snapshot, current, 0.1));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -17,6 +17,7 @@
  */
 
 #include <gtsam/base/DSFVector.h>
+#include <gtsam/base/ConcurrentDSFVector.h>
 #include <gtsam_unstable/base/DSF.h>
 #include <gtsam/base/DSFMap.h>
 
@@ -40,7 +41,7 @@ int main(int argc, char* argv[]) {
 
   // Create CSV file for results
   ofstream os("dsf-timing.csv");
-  os << "images,points,matches,Base,Map,BTree" << endl;
+  os << "images,points,matches,Base,Concurrent,Map,BTree" << endl;
 
   // loop over number of images
   vector<size_t> ms;
@@ -79,6 +80,15 @@ int main(int argc, char* argv[]) {
       cout << format("DSFBase: %1% s") % tim.elapsed() << endl;
     }
 
+    {
+      // ConcurrentDSFBase version, merges in parallel if TBB is enabled
+      timer tim;
+      ConcurrentDSFBase dsf(N); // Allow for N keys
+      dsf.merge(matches);
+      os << tim.elapsed() << ",";
+      cout << format("ConcurrentDSFBase: %1% s") % tim.elapsed() << endl;
+    }
+
     {
       // DSFMap version
       timer tim;
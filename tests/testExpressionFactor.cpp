@@ -23,7 +23,9 @@
 #include <gtsam/slam/PriorFactor.h>
 #include <gtsam/nonlinear/expressionTesting.h>
 #include <gtsam/nonlinear/ExpressionFactor.h>
+#include <gtsam/nonlinear/ExpressionFactorGraph.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/nonlinear/expressionTesting.h>
 #include <gtsam/base/Testable.h>
 
@@ -190,7 +192,7 @@ TEST(ExpressionFactor, Binary) {
   size_t size = binary.traceSize();
   // Use Variable Length Array, allocated on stack by gcc
   // Note unclear for Clang: http://clang.llvm.org/compatibility.html#vla
-  internal::ExecutionTraceStorage traceStorage[size];
+  internal::ExecutionTraceStorage traceStorage[internal::traceSlots(size)];
   internal::ExecutionTrace<Point2> trace;
   Point2 value = binary.traceExecution(values, trace, traceStorage);
   EXPECT(assert_equal(Point2(0,0),value, 1e-9));
@@ -244,7 +246,7 @@ TEST(ExpressionFactor, Shallow) {
   // traceExecution of shallow tree
   typedef internal::UnaryExpression<Point2, Point3> Unary;
   size_t size = expression.traceSize();
-  internal::ExecutionTraceStorage traceStorage[size];
+  internal::ExecutionTraceStorage traceStorage[internal::traceSlots(size)];
   internal::ExecutionTrace<Point2> trace;
   Point2 value = expression.traceExecution(values, trace, traceStorage);
   EXPECT(assert_equal(Point2(0,0),value, 1e-9));
@@ -630,6 +632,37 @@ TEST(ExpressionFactor, MultiplyWithInverseFunction) {
   EXPECT_CORRECT_FACTOR_JACOBIANS(factor, values, 1e-5, 1e-5);
 }
 
+/* ************************************************************************* */
+// Batched linearization must match factor-by-factor linearization
+TEST(ExpressionFactor, LinearizeBatched) {
+  const Cal3_S2 K(500, 500, 0, 320, 240);
+  Values values;
+  for (size_t j = 0; j < 2; j++)
+    values.insert(Symbol('x', j), Pose3(Rot3::Ypr(0.1 * j, 0, 0), Point3(j, 0, -5)));
+  for (size_t l = 0; l < 3; l++)
+    values.insert(Symbol('l', l), Point3(0.1 * l, 0.2, 1.0));
+
+  ExpressionFactorGraph graph;
+  const Cal3_S2_ K_(K);
+  for (size_t j = 0; j < 2; j++) {
+    for (size_t l = 0; l < 3; l++) {
+      const Point2_ prediction = uncalibrate(K_,
+          project(transformTo(Pose3_(Symbol('x', j)), Point3_(Symbol('l', l)))));
+      graph.addExpressionFactor(prediction, Point2(320 + l, 240 - j), model);
+    }
+  }
+  // Factors with a different shape and a non-expression factor
+  graph.addExpressionFactor(Point3_(Symbol('l', 0)), Point3(0, 0.2, 1.0),
+                            noiseModel::Unit::Create(3));
+  graph.push_back(boost::shared_ptr<NonlinearFactor>());
+  graph.push_back(PriorFactor<Pose3>(Symbol('x', 0), Pose3(),
+                                     noiseModel::Unit::Create(6)));
+
+  const GaussianFactorGraph expected = *graph.linearize(values);
+  const GaussianFactorGraph actual = *graph.linearizeBatched(values);
+  EXPECT(assert_equal(expected, actual, 1e-9));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
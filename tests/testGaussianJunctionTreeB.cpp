@@ -131,6 +131,55 @@ TEST( GaussianJunctionTreeB, constructor2 ) {
   EXPECT_LONGS_EQUAL(4, x1->problemSize_);
 }
 
+/* ************************************************************************* */
+TEST( GaussianJunctionTreeB, relaxedAmalgamation ) {
+  NonlinearFactorGraph nlfg;
+  Values values;
+  boost::tie(nlfg, values) = createNonlinearSmoother(7);
+  GaussianFactorGraph::shared_ptr fg = nlfg.linearize(values);
+
+  Ordering ordering;
+  ordering += X(1), X(3), X(5), X(7), X(2), X(6), X(4);
+  GaussianEliminationTree etree(*fg, ordering);
+
+  // Exact merging gives four cliques, see constructor2 above
+  GaussianBayesTree::shared_ptr exact =
+      GaussianJunctionTree(etree).eliminate(EliminateCholesky).first;
+  EXPECT_LONGS_EQUAL(1, exact->roots().size());
+  EXPECT_LONGS_EQUAL(2, exact->roots().front()->children.size());
+
+  // Allowing a few zeros also merges x1 into the x3 x2 x4 clique, and x7 into
+  // the x5 x6 clique, but not the two remaining cliques
+  GaussianJunctionTree some(etree, AmalgamationParams(0.25));
+  LONGS_EQUAL(1, some.roots().size());
+  GaussianJunctionTree::sharedNode x1324 = some.roots().front();
+  EXPECT_LONGS_EQUAL(4, x1324->nrFrontals());
+  LONGS_EQUAL(1, x1324->children.size());
+  EXPECT_LONGS_EQUAL(3, x1324->children.front()->nrFrontals());
+  EXPECT_LONGS_EQUAL(0, x1324->children.front()->children.size());
+
+  // Allowing any number of zeros gives a single dense clique
+  GaussianJunctionTree all(etree, AmalgamationParams(1.0));
+  LONGS_EQUAL(1, all.roots().size());
+  EXPECT_LONGS_EQUAL(7, all.roots().front()->nrFrontals());
+  EXPECT_LONGS_EQUAL(0, all.roots().front()->children.size());
+
+  // ... unless relaxed merges are capped, exact merges still happen
+  GaussianJunctionTree capped(etree, AmalgamationParams(1.0, 3));
+  LONGS_EQUAL(1, capped.roots().size());
+  EXPECT_LONGS_EQUAL(4, capped.roots().front()->nrFrontals());
+  EXPECT_LONGS_EQUAL(1, capped.roots().front()->children.size());
+
+  // The solution does not depend on the clique structure
+  const VectorValues expected = exact->optimize();
+  EXPECT(assert_equal(expected,
+      some.eliminate(EliminateCholesky).first->optimize(), 1e-9));
+  EXPECT(assert_equal(expected,
+      all.eliminate(EliminateCholesky).first->optimize(), 1e-9));
+  EXPECT(assert_equal(expected,
+      capped.eliminate(EliminateCholesky).first->optimize(), 1e-9));
+}
+
 ///* ************************************************************************* */
 //TEST( GaussianJunctionTreeB, optimizeMultiFrontal )
 //{
@@ -33,6 +33,7 @@
 
 #include <boost/range/adaptor/map.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/assign/std/list.hpp> // for operator +=
 using namespace boost::assign;
 using boost::adaptors::map_values;
@@ -152,6 +153,28 @@ TEST( NonlinearOptimizer, SimpleDLOptimizer )
   DOUBLES_EQUAL(0,fg.error(actual),tol);
 }
 
+/* ************************************************************************* */
+TEST( NonlinearOptimizer, OrderingCache )
+{
+  NonlinearFactorGraph fg(example::createReallyNonlinearFactorGraph());
+
+  Point2 x0(3,3);
+  Values c0;
+  c0.insert(X(1), x0);
+
+  // The second run finds the ordering of the first one in the cache
+  LevenbergMarquardtParams lmParams;
+  lmParams.orderingCache = boost::make_shared<OrderingCache>();
+  GaussNewtonParams gnParams;
+  gnParams.orderingCache = lmParams.orderingCache;
+  Values actual1 = LevenbergMarquardtOptimizer(fg, c0, lmParams).optimize();
+  Values actual2 = GaussNewtonOptimizer(fg, c0, gnParams).optimize();
+  DOUBLES_EQUAL(0,fg.error(actual1),tol);
+  DOUBLES_EQUAL(0,fg.error(actual2),tol);
+  LONGS_EQUAL(1, lmParams.orderingCache->nrMisses());
+  LONGS_EQUAL(1, lmParams.orderingCache->nrHits());
+}
+
 /* ************************************************************************* */
 TEST( NonlinearOptimizer, optimization_method )
 {
@@ -0,0 +1,76 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeKalmanFilter.cpp
+ * @brief   time KalmanFilter against FixedKalmanFilter
+ */
+
+#include <iostream>
+
+#include <gtsam/base/timing.h>
+#include <gtsam/linear/KalmanFilter.h>
+#include <gtsam/linear/FixedKalmanFilter.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+#define TEST(TITLE,STATEMENT) \
+  gttic_(TITLE); \
+  for(int i = 0; i < n; i++) \
+  STATEMENT; \
+  gttoc_(TITLE);
+
+int main()
+{
+  int n = 100000;
+  cout << "NOTE:  Times are reported for " << n << " calls" << endl;
+
+  // Constant velocity model in 2D, with position measurements
+  const double dt = 0.1;
+  Matrix4 F = I_4x4;
+  F(0, 2) = F(1, 3) = dt;
+  const Eigen::Matrix<double, 4, 1> B = Eigen::Matrix<double, 4, 1>::Zero();
+  const Eigen::Matrix<double, 1, 1> u = Eigen::Matrix<double, 1, 1>::Zero();
+  const Eigen::Matrix<double, 2, 4> H = (Eigen::Matrix<double, 2, 4>() <<
+      1, 0, 0, 0,
+      0, 1, 0, 0).finished();
+  const Vector2 z(1.0, 2.0);
+  const Matrix4 Q = 0.01 * I_4x4;
+  const Matrix2 R = 0.1 * I_2x2;
+  SharedDiagonal modelQ = noiseModel::Isotropic::Sigma(4, 0.1);
+  SharedDiagonal modelR = noiseModel::Isotropic::Sigma(2, 0.3);
+  SharedDiagonal P0 = noiseModel::Isotropic::Sigma(4, 1.0);
+
+  KalmanFilter kf(4);
+  KalmanFilter::State p = kf.init(Vector4::Zero(), P0);
+  TEST(KalmanFilter_predict, p = kf.predict(p, F, B, u, modelQ))
+  TEST(KalmanFilter_update, p = kf.update(p, H, z, modelR))
+  TEST(KalmanFilter_predictQ, p = kf.predictQ(p, F, B, u, Q))
+  TEST(KalmanFilter_updateQ, p = kf.updateQ(p, H, z, R))
+
+  FixedKalmanFilter<4> fkf;
+  FixedKalmanFilter<4>::State q = fkf.init(Vector4::Zero(), P0);
+  TEST(FixedKalmanFilter_predict, q = fkf.predict(q, F, B, u, modelQ))
+  TEST(FixedKalmanFilter_update, q = fkf.update(q, H, z, modelR))
+  TEST(FixedKalmanFilter_predictQ, q = fkf.predictQ(q, F, B, u, Q))
+  TEST(FixedKalmanFilter_updateQ, q = fkf.updateQ(q, H, z, R))
+
+  // Print timings
+  tictoc_print_();
+
+  // Both filters should agree
+  cout << "KalmanFilter mean:      " << p->mean().transpose() << endl;
+  cout << "FixedKalmanFilter mean: " << q.mean().transpose() << endl;
+
+  return 0;
+}
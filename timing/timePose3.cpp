@@ -18,7 +18,7 @@
 #include <iostream>
 
 #include <gtsam/base/timing.h>
-#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/BatchPose3.h>
 
 using namespace std;
 using namespace gtsam;
@@ -48,6 +48,18 @@ int main()
   TEST(between_derivatives, T.between(T2,H1,H2))
   TEST(Logmap, Pose3::Logmap(T.between(T2)))
 
+  // Batched versions, in blocks of m, for the same total number of calls
+  const size_t m = 1000;
+  batch::Pose3s Ts(m, T), T2s(m, T2), results;
+  batch::Vector6s vs(m, v);
+  batch::Vector6s locals;
+  batch::Matrix6s H1s, H2s;
+  n /= m;
+  TEST(batch_retract, batch::retract(Ts, vs, &results))
+  TEST(batch_localCoordinates, batch::localCoordinates(Ts, T2s, &locals))
+  TEST(batch_between, batch::between(Ts, T2s, &results))
+  TEST(batch_between_derivatives, batch::between(Ts, T2s, &results, &H1s, &H2s))
+
   // Print timings
   tictoc_print_();
 